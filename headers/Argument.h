@@ -1,18 +1,23 @@
 #pragma once
 #include <memory>
+#include <vector>
+#include <cstdint>
+#include <string_view>
 #include <iostream>
 #include <functional>
+#include <type_traits>
+#include <future>
+#include <chrono>
 #include "Validator.h"
 #include "Context.h"
 #include "Cursor.h"
+#include "Environment.h"
+#include "Configuration.h"
 #include "Error.h"
 
 namespace az::cli
 {
 
-// TODO: support name patterns (-DFLAG, -P/path/to/file)
-// TODO: support multi value arguments (--arg val1 val2)
-// TODO: add an ability to store values to standard types
 class Argument
 {
 public:
@@ -44,18 +49,47 @@ public:
 		}
 	};
 
+	// Callback to check if an argv string is a key of any discovered argument
+	using Recognizer = std::function<bool(const char*)>;
+
+	// Callback to consume each value of the argument as it's parsed
+	using Each = std::function<void(const Value&)>;
+
 	// Callbacks handler to perform user input & errors handling
 	struct Interactor {
 		using Input = std::function<std::string(const Argument&)>;
+		// Input which is resolved later, e.g: by a promise fulfilled from an event loop
+		// The future is waited for by the parsing thread, so it should be fulfilled by another thread;
+		//   parsing isn't suspended, so an event loop of the parsing thread would never fulfil it
+		// The future shouldn't block on destruction (unlike one of std::async) to be abandoned by @timeout
+		using AsyncInput = std::function<std::future<std::string>(const Argument&)>;
 		using Blame = std::function<void(const Error&)>;
 
 		Input input;
 		Blame blame;
+		AsyncInput async_input;
+		// time to wait for each async input; the default value is used after it (0 means no limit)
+		std::chrono::milliseconds timeout{0};
 
 		Interactor(const Input& input = {}, const Blame& blame = {})
 			: input(input), blame(blame) {}
+		Interactor(const AsyncInput& async_input, std::chrono::milliseconds timeout, const Blame& blame = {})
+			: blame(blame), async_input(async_input), timeout(timeout) {}
 		operator bool() const {
-			return input && blame;
+			return (input || async_input) && blame;
+		}
+	};
+
+	// Key of the argument with precomputed hash for matching without allocations
+	struct Key {
+		std::string name;
+		size_t hash = 0;
+
+		Key(const std::string& name)
+			: name(name), hash(Argument::hash(name)) {}
+		bool operator==(std::string_view key) const {
+			// compare length & first character before comparing the whole key
+			return name.size() == key.size() && name[0] == key[0] && name == key;
 		}
 	};
 
@@ -86,6 +120,12 @@ public:
 	//   if the argument IS NOT passed via command line
 	Argument& by_default(const Value&);
 
+	// Takes the argument value from the environment variable @name if the argument IS NOT passed via command line
+	// The value is validated like a passed one and has priority over input and default values
+	// A variable of an argument without value is taken as a bool (e.g: 1, yes, true) whether the argument is passed
+	// A variable of a counting() argument is taken as the count; an empty variable is taken as unset one
+	Argument& from_env(const std::string& name);
+
 	// Allow the argument to be passed several times
 	Argument& multiple(bool whether = true);
 
@@ -96,15 +136,63 @@ public:
 	// Useful when there is a need to control an argument's availability by a flag
 	Argument& disabled(bool whether = true);
 
-	// Requires multiple arguments to contain only unique values
+	// Requires multiple arguments to contain only unique values which are checked by a hash set of a run
 	Argument& unique(bool whether = true);
 
 	// Makes the argument non printable but able to be passed
 	Argument& hidden(bool whether = true);
 
+	// Makes the argument keys prefixes of the argument value, e.g: -I/path/to/dir for the key -I
+	// The value can still be passed separately, e.g: -I /path/to/dir
+	Argument& prefixed(bool whether = true);
+
+	// Allows the argument to take from @min to @max values at once, e.g: --files a.txt b.txt c.txt
+	// Values are taken till @max of them or till a recognized argument and stored as an array
+	// Provokes Error::Code::TooFew if there are less than @min values
+	Argument& arity(uint32_t min, uint32_t max = UINT32_MAX);
+
+	// Makes the argument count how many times it is passed instead of storing its value, e.g: -vvv gives 3
+	// The counter is stored to the @Context as an integer which is 0 or the default value if it's not passed
+	Argument& counting(bool whether = true);
+
+	// Makes the argument multiple and lets it read values from a stream instead of the command line,
+	//   e.g: --id - reads ids from stdin and --id &3 reads them from the file descriptor 3
+	//   if the interpreter allows descriptors (see Interpreter::allowDescriptors)
+	// Values are read in chunks, split by @delimiter ('\n' or '\0' like xargs -0) and stored one by one,
+	//   so the memory depends only on how values are kept (see bind_to with detached)
+	// Empty values are skipped; other values are taken from the command line as usual
+	Argument& streamed(char delimiter = '\n');
+
+	// Splits the argument value by @separator into a pair of name and value, e.g: -DNAME=value
+	//   gives {"NAME", "value"} where only the value is validated; it is None if there is no @separator
+	// Useful with prefixed() and multiple() to collect definitions
+	Argument& paired(char separator = '=');
+
+	// Binds the argument to @variable which is assigned the parsed value at once, e.g: int, double, bool,
+	//   std::string, enums or std::vector of them which is appended by multiple arguments and arity
+	// The value isn't stored to the @Context if @detached, the argument is only marked as passed there
+	// The @variable should outlive parsing
+	template<typename T> Argument& bind_to(T& variable, bool detached = false) {
+		binding = [&variable](const Value& value) { assign(variable, value); };
+		return setFlag(DETACHED, detached);
+	}
+
+	// Hands each validated value to @each as it's parsed instead of storing it to the @Context,
+	//   the argument is only marked as passed there, e.g: to process millions of streamed() values
+	// If @queue_size isn't 0, values are consumed by a worker thread through a queue of the size,
+	//   so parsing waits while the queue is full; the worker is joined when values are provided (see provideValue)
+	// Uniqueness of values (see unique) is checked by a hash set of values passed since then
+	// An error thrown by @each is rethrown when the worker is joined, the following values are dropped
+	// The queue, the worker and the hash set are kept in the @Context, so concurrent runs don't share them,
+	//   but @each is shared by copies of the argument and should be safe to be called by them
+	Argument& on_each(const Each& each, size_t queue_size = 0);
+
 	// Set callbacks to perform action
 	Argument& with_action(const Action::Easy&);
 	Argument& with_action(const Action::Full&);
+	// Makes the action be performed after actions of arguments with @id when they are performed in parallel
+	// See Interpreter::inParallel
+	Argument& after(int id);
 
 	// Get the argument id
 	int id() const;
@@ -115,6 +203,8 @@ public:
 	std::string getKeysString() const;
 	// Get a list of the argument keys
 	std::list<std::string> getKeys() const;
+	// Get the argument keys with their hashes
+	const std::vector<Key>& getHashedKeys() const;
 
 	// Get description of the argument value
 	std::string getValidation() const;
@@ -137,11 +227,19 @@ public:
 	bool isUnique() const;
 	// Check if the argument is hidden
 	bool isHidden() const;
-	// Check if the argument has a value and should be stored to the @Context
+	// Check if the argument keys are prefixes of its value
+	bool isPrefixed() const;
+	// Check if the argument counts how many times it is passed
+	bool isCounting() const;
+	// Check if the argument reads values from streams
+	bool isStreamed() const;
+	// Check if the argument has a value and should be stored to the @Context or bound to a variable
 	bool isValuable() const;
 
 	// Check if the argument has an action
 	bool hasAction() const;
+	// Get ids of arguments which actions should be performed before the action of the argument
+	const std::vector<int>& getDependencies() const;
 	// Check if the argument expects a value
 	bool needValue() const;
 	// Check if the argument has a default value
@@ -153,19 +251,34 @@ public:
 	Value getValidatedDefaultValue() const;
 	// Get the argument's certain value
 	Value getCertainValue() const;
-	// Provide the @Context with input or default value
+	// Get the name of the environment variable of the argument value; it's empty if there is no one
+	std::string getVariableName() const;
+	// Provide the @Context with a value of the environment variable, configuration @Setting, input or default value
 	// Throws Error::Code::RequireArgument if the argument is required but not presented in @Context
-	void provideValue(const Interactor&, Context&) const;
+	// Errors of the @Setting value are located at its file and line
+	void provideValue(const Interactor&, Context&, const Environment* = nullptr, const Setting* = nullptr) const;
 
 	// Parse the argument using @Cursor for access to [argv, argc]
 	//  and fill @Context with parsed values
-	bool parse(Cursor&, Context&) const;
+	// Values of the argument with arity are taken till a string that is known by @Recognizer
+	bool parse(Cursor&, Context&, const Recognizer& = {}) const;
+	// Does the same for @arg which is already matched with the cursor's one (see match())
+	bool parse(const char* arg, Cursor&, Context&, const Recognizer& = {}) const;
 
 	// Matches @arg with the argument keys and returns:
 	//  - @arg if 100% matched
 	//  - value pos for expressions like @key=value
 	//  - nullptr if no match at all
 	const char* match(const char* arg) const;
+	// Checks if @key is one of the argument keys; @hash should be Argument::hash(@key)
+	bool hasKey(std::string_view key, size_t hash) const;
+	bool hasKey(std::string_view key) const;
+	// Get a part of @arg which is supposed to be a key; e.g: --key for --key=value
+	static std::string_view getKeyOf(const char* arg);
+	// Get @arg as match() returns it if the key of @arg is matched
+	static const char* getValueOf(const char* arg);
+	// Get a hash of @key used for matching
+	static size_t hash(std::string_view key);
 
 	// Perform an action of the argument
 	int perform(const Context&) const;
@@ -175,16 +288,82 @@ public:
 
 private:
 	bool validate(const char* arg, Value&) const;
+	// Validate @arg as a value or a pair of values
+	Value take(const char* arg) const;
+	// Store values read from the stream which @arg refers to; returns false if @arg isn't a stream
+	bool stream(const char* arg, const Cursor&, Context&) const;
 	void store(const Value&, Context&) const;
 
+	template<typename T> static void assign(T& variable, const Value& value) {
+		if constexpr (std::is_same_v<T, bool>) {
+			variable = value.isNone() || bool(value); // a passed argument without value is a switched flag
+		}
+		else if constexpr (std::is_enum_v<T> || std::is_integral_v<T>) {
+			variable = static_cast<T>(int64_t(value));
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			variable = static_cast<T>(double(value));
+		}
+		else {
+			variable = T(value);
+		}
+	}
+	template<typename T> static void assign(std::vector<T>& variable, const Value& value) {
+		auto append = [&variable](const Value& value) {
+			T item{};
+			assign(item, value);
+			variable.push_back(std::move(item));
+		};
+		if (!value.isArray()) {
+			append(value);
+			return;
+		}
+		for (const auto& item : value) {
+			append(item);
+		}
+	}
+
 private:
-	enum class Attribute {
-		ID = 0, KEYS, DESCRIPTION, DEFAULT_VALUE, CERTAIN_VALUE,
-		REQUIRED, MULTIPLE, DISABLED, UNIQUE, HIDDEN
+	enum Flag : uint16_t {
+		REQUIRED = 1 << 0,
+		MULTIPLE = 1 << 1,
+		DISABLED = 1 << 2,
+		UNIQUE = 1 << 3,
+		HIDDEN = 1 << 4,
+		PREFIXED = 1 << 5,
+		DETACHED = 1 << 6,
+		COUNTING = 1 << 7,
+		STREAMED = 1 << 8
+	};
+	// Names of the argument which never change after construction, so they're shared by copies
+	struct Names {
+		std::vector<Key> keys;
+		std::string longest_key;
+		std::string keys_string;
+		std::string description;
 	};
-	std::map<Attribute,Value> attributes;
+	Argument& setFlag(Flag, bool);
+	bool hasFlag(Flag) const;
+	// State of consumption of values by on_each during a run
+	struct Consumption;
+
+private:
+	int identifier = 0;
+	uint16_t flags = 0;
+	char separator = 0;
+	char delimiter = '\n';
+	uint32_t min_values = 1;
+	uint32_t max_values = 1;
+	std::shared_ptr<const Names> names;
+	std::shared_ptr<const Value> default_value;
+	std::shared_ptr<const Value> certain_value;
+	std::shared_ptr<const std::string> variable_name;
 	std::shared_ptr<Validator> validator;
 	Action action;
+	std::vector<int> dependencies;
+	std::function<void(const Value&)> binding;
+	Each consumer;
+	size_t queue_size = 0;
 };
 
 using Arg = Argument;
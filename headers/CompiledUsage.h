@@ -0,0 +1,40 @@
+#pragma once
+#include <unordered_map>
+#include "Argument.h"
+#include "Group.h"
+
+namespace az::cli
+{
+
+// Hierarchy of argument groups described by @Usage which is walked once from the app argument
+// Groups are indexed at once and never change after construction,
+//   so any number of interpreters can share the compiled usage without calling @Usage again
+// @Usage should describe arguments groups by ids of parent arguments
+// Actions, validators, bound variables and on_each callbacks of the arguments are shared by all the runs as well,
+//   so they should be safe to be used by concurrent threads; states of runs are kept in their contexts
+class CompiledUsage
+{
+public:
+	CompiledUsage(const Argument& app, const Usage&);
+	// Copies of groups would be indexed again on demand, which isn't safe for sharing, so there are no copies
+	CompiledUsage(const CompiledUsage&) = delete;
+	CompiledUsage& operator=(const CompiledUsage&) = delete;
+
+	// Get the app argument
+	const Argument& root() const;
+	// Get the group of arguments of @argument; it's empty if @argument has no arguments
+	const Group& group(const Argument& argument) const;
+	// Get @Usage returning copies of the compiled groups, e.g: for printing
+	Usage usage() const;
+
+private:
+	void compile(const Argument& argument, const Usage&);
+
+private:
+	Argument app;
+	// groups of arguments by ids of their parent arguments
+	std::unordered_map<int, Group> groups;
+	Group no_group;
+};
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <list>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include "MappedFile.h"
+
+namespace az::cli
+{
+
+class Argument;
+
+// Value of an argument taken from a configuration file
+struct Setting {
+	const char* value = nullptr;
+	// location of the value to blame it if it's invalid
+	const std::string* file = nullptr;
+	uint32_t line = 0;
+};
+
+// Layered configuration of INI files which provide argument values below the command line and environment variables
+//   and above input and defaults
+// Keys are argument keys without leading dashes, e.g: verbose = yes for --verbose
+// Sections are subcommands, so [remote.add] holds values of arguments of the add subcommand of remote one
+// Files are mapped and scanned once; keys and values refer to the mapped content without copying
+class Configuration
+{
+public:
+	class Section
+	{
+	public:
+		// Find the setting having any key of @argument; returns nullptr if there is no such setting
+		const Setting* find(const Argument&) const;
+		// Find the section of subcommand @argument; returns nullptr if there is no such section
+		const Section* section(const Argument&) const;
+
+	private:
+		friend class Configuration;
+		std::unordered_map<std::string_view, Setting> settings;
+		std::unordered_map<std::string_view, std::unique_ptr<Section>> sections;
+	};
+
+	// Load the file at @path over already loaded ones, so its settings override theirs
+	// Throws Error::Code::InvalidArgument if the file can't be read
+	//   and Error::Code::InvalidValue located at a malformed line of the file
+	Configuration& load(const std::string& path);
+
+	// Get the section of the app arguments which are outside of any [section]
+	const Section& root() const;
+
+private:
+	Section top;
+	std::list<MappedFile> files;
+	// values which can't be terminated in files
+	std::list<std::string> copies;
+};
+
+}
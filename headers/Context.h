@@ -1,5 +1,6 @@
 #pragma once
 #include <map>
+#include <memory>
 #include "Value.h"
 
 namespace az::cli
@@ -9,6 +10,8 @@ class Context
 {
 	// TODO: implement smart Key structure for the map to store ids and names
 	std::map<int,Value> map;
+	// states of arguments kept during a run by ids, e.g: of arguments consuming their values (see Argument::on_each)
+	std::map<int,std::shared_ptr<void>> states;
 public:
 	Value get(int id) const {
 		auto it = map.find(id);
@@ -40,6 +43,14 @@ public:
 	bool empty() const {
 		return map.empty();
 	}
+	// Get the state of the argument with @id which is empty if there is no one
+	std::shared_ptr<void>& state(int id) {
+		return states[id];
+	}
+	// Drop states of all arguments, e.g: left by an interrupted run
+	void clearStates() {
+		states.clear();
+	}
 };
 
 }
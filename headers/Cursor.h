@@ -1,33 +1,80 @@
 #pragma once
+#include <memory>
+#include <vector>
+#include <cstdint>
 
 namespace az::cli
 {
 
 // Class for access to program args
+// Can expand @path args into args of files at the paths (response files) which may refer to other files
+// Files are memory mapped and split into args one by one as the cursor moves, so a huge list of args
+//   is never kept entirely; an arg of a file stays valid till the cursor passes the next one
 class Cursor {
-	const char** arg_vector = nullptr;
-	uint32_t arg_count = 0;
-	uint32_t arg_index = 0;
 public:
 	Cursor(const char** argv, uint32_t argc)
 		: arg_vector(argv), arg_count(argc) {}
-	Cursor& operator++() {
-		arg_index++;
+
+	// Turns expanding of @path args on or off
+	// Throws Error::Code::InvalidArgument if a file can't be read or files refer to each other too deep
+	//   and Error::Code::InvalidEnd located at the line of a file where a quote is not closed
+	Cursor& expandFiles(bool whether = true);
+	// Turns reading of streamed values from file descriptors (&N args) on or off
+	Cursor& allowDescriptors(bool whether = true) {
+		allow_descriptors = whether;
 		return *this;
 	}
+	bool allowsDescriptors() const {
+		return allow_descriptors;
+	}
+
+	// move back to the first arg
+	void rewind();
+	Cursor& operator++();
+	// number of args passed by the cursor
 	int pos() const {
-		return arg_index;
+		return position;
 	}
 	// end of line
 	bool eol() const {
-		return arg_index >= arg_count;
+		return frames.empty() && arg_index >= arg_count;
 	}
 	operator bool() const {
 		return !eol();
 	}
 	const char* arg() const {
+		if (!frames.empty()) {
+			return frames.back().arg;
+		}
 		return eol() ? nullptr : arg_vector[arg_index];
 	}
+
+private:
+	// Mapped response file
+	struct File;
+	// Position in a response file
+	struct Frame {
+		std::shared_ptr<File> file;
+		const char* arg = nullptr;
+		size_t next = 0; // offset of the rest of the file
+		size_t line = 1; // line of the rest of the file
+	};
+	// Replace the current arg by args of the file it refers to
+	void expand();
+	// Move @frame to the next arg of its file; returns false if there is no more args
+	bool advance(Frame& frame);
+
+private:
+	const char** arg_vector = nullptr;
+	uint32_t arg_count = 0;
+	uint32_t arg_index = 0;
+	int position = 0;
+	bool expand_files = false;
+	bool allow_descriptors = false;
+	// nested response files which args are passed by the cursor
+	std::vector<Frame> frames;
+	// file of the previous arg which is kept for the arg to stay valid
+	std::shared_ptr<File> passed;
 };
 
 }
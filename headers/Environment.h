@@ -0,0 +1,27 @@
+#pragma once
+#include <string_view>
+#include <unordered_map>
+
+namespace az::cli
+{
+
+// Index of environment variables of the process
+// Variables are read at once on first search, so any number of them are found without scanning the environment
+class Environment
+{
+public:
+	// Find the value of the variable with @name; returns nullptr if there is no such variable
+	const char* find(std::string_view name) const;
+	// Forget the variables to read them again on next search
+	void clear();
+
+private:
+	void index() const;
+
+private:
+	// values of variables by names; names refer to the environment of the process
+	mutable std::unordered_map<std::string_view, const char*> variables;
+	mutable bool indexed = false;
+};
+
+}
@@ -28,28 +28,37 @@ struct Error : public std::exception
 		TooShort,
 		TooLong,
 		TooSmall,
-		TooLarge
+		TooLarge,
+		AmbiguousArgument,
+		Unexpected // an exception which isn't Error, e.g: thrown by an action; help() tells what it is
 	};
 	struct Context {
 		Code code = Code::None;
 		std::string argument;
 		std::string value;
 		std::string help;
+		// location of the value in a file, e.g: a configuration one
+		std::string file;
+		size_t line = 0;
 	};
 	Error(Code code);
 	Error& argument(const std::string& argument);
 	Error& value(const std::string& value);
 	Error& help(const std::string& help);
+	Error& location(const std::string& file, size_t line);
 
 	virtual const char* what() const noexcept;
 	const char* argument() const;
 	const char* value() const;
 	const char* help() const;
+	const char* file() const;
+	size_t line() const;
 	Code code() const;
 
 	bool hasArgument() const;
 	bool hasValue() const;
 	bool hasHelp() const;
+	bool hasLocation() const;
 
 	Context context;
 };
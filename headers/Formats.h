@@ -0,0 +1,94 @@
+#pragma once
+#include <string_view>
+#include "Validator.h"
+
+namespace az::cli
+{
+
+// Base of validators of well-known formats which are parsed in one pass without regular expressions
+// Any of them can be used as with_value<Ipv4Validator>(rules) where @rules are additional ones
+class FormatValidator : public Validator
+{
+public:
+	// Checks if the @source string is written in the format and then checks other rules
+	// Provokes Error::Code::InvalidValue with the format description as help
+	bool check(const std::string& source) const override;
+	// The format is checked only by the whole value
+	bool isStreamable() const override;
+protected:
+	// @format is a short description of the format which is shown in errors
+	FormatValidator(const char* format);
+	// Checks if the @source string is written in the format
+	virtual bool accepts(std::string_view source) const = 0;
+private:
+	const char* format;
+};
+
+// Validator of IPv4 addresses in dotted decimal notation; e.g: 192.168.0.1
+// Converts an address into an integer number in host byte order
+class Ipv4Validator : public FormatValidator
+{
+public:
+	Ipv4Validator();
+	Value apply(const std::string& source) const override;
+	// Parses the @source into the @address; returns false if the @source is not an address
+	static bool parse(std::string_view source, uint32_t& address);
+protected:
+	bool accepts(std::string_view source) const override;
+};
+
+// Validator of UUIDs written as 8-4-4-4-12 hexadecimal digits, optionally in braces
+// Converts a UUID into a lower cased string without braces
+class UuidValidator : public FormatValidator
+{
+public:
+	UuidValidator();
+	Value apply(const std::string& source) const override;
+	// Parses the @source into the canonical @uuid; returns false if the @source is not a UUID
+	static bool parse(std::string_view source, char (&uuid)[37]);
+protected:
+	bool accepts(std::string_view source) const override;
+};
+
+// Validator of ISO 8601 dates and times; e.g: 2021-12-31, 2021-12-31T23:59:59.999+03:00
+// Time is optional and a date & time without a zone is supposed to be in UTC
+// Converts a date & time into an integer number of seconds since the Unix epoch
+class Iso8601Validator : public FormatValidator
+{
+public:
+	Iso8601Validator();
+	Value apply(const std::string& source) const override;
+	// Parses the @source into the @seconds since the epoch; returns false if the @source is not a date
+	static bool parse(std::string_view source, int64_t& seconds);
+protected:
+	bool accepts(std::string_view source) const override;
+};
+
+// Validator of hexadecimal tokens; e.g: a hash sum like d41d8cd98f00b204e9800998ecf8427e
+// Min & max rules restrict the number of digits
+// Converts a token into a lower cased string
+class HexValidator : public FormatValidator
+{
+public:
+	HexValidator();
+	Value apply(const std::string& source) const override;
+protected:
+	bool accepts(std::string_view source) const override;
+};
+
+// Validator of sizes written as a number with an optional binary unit suffix
+//   K, M, G, T, P or E (case insensitive, optionally followed by iB or B); e.g: 512, 4k, 16MiB, 2GB
+// Min & max rules restrict the size in bytes
+// Converts a size into an integer number of bytes
+class SizeValidator : public FormatValidator
+{
+public:
+	SizeValidator();
+	Value apply(const std::string& source) const override;
+	// Parses the @source into the @bytes; returns false if the @source is not a size or it's too large
+	static bool parse(std::string_view source, int64_t& bytes);
+protected:
+	bool accepts(std::string_view source) const override;
+};
+
+}
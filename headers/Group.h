@@ -0,0 +1,99 @@
+#pragma once
+#include <list>
+#include <array>
+#include <vector>
+#include <string_view>
+#include "Argument.h"
+#include "Trie.h"
+
+namespace az::cli
+{
+
+// Group of sibling arguments returned by @Usage for a parent argument
+// Builds an index of the keys on first search, so an argument is found in O(1) for any group size
+class Group
+{
+public:
+	Group() = default;
+	Group(const Group&);
+	Group(Group&&) = default;
+	Group(const std::list<Argument>&);
+	Group(std::list<Argument>&&);
+
+	// Find an enabled argument which has the key of @arg (see Argument::match)
+	// If several arguments have the same key, the first one is found
+	// Returns nullptr if there is no such argument
+	const Argument* find(const char* arg) const;
+	// Find an enabled argument which is the only one having keys starting with the key of @arg
+	// Throws Error::Code::AmbiguousArgument listing the candidates if there are several ones
+	// Returns nullptr if there is no such argument
+	const Argument* complete(const char* arg) const;
+	// Find an enabled prefixed argument (see Argument::prefixed) with the longest key which @arg starts with
+	// Sets @value to the rest of @arg; returns nullptr if there is no such argument
+	const Argument* findByPrefix(const char* arg, const char*& value) const;
+	// Find an enabled argument having the single character key -@key, e.g: -v for 'v'
+	// Returns nullptr if there is no such argument
+	const Argument* findShort(char key) const;
+	// Check if any argument, even a disabled one, has the key of @arg
+	bool recognize(const char* arg) const;
+
+	// Build the indexes at once instead of on first search, so the group can be shared by threads
+	void compile() const;
+
+	bool empty() const;
+	size_t size() const;
+	std::list<Argument>::const_iterator begin() const;
+	std::list<Argument>::const_iterator end() const;
+
+private:
+	void index() const;
+	void insert(const Argument::Key& key, const Argument* argument) const;
+	// Find an argument, even a disabled one, which has the key of @arg
+	const Argument* lookup(const char* arg) const;
+	void indexCompletions() const;
+
+private:
+	// open addressing hash table of keys; a slot without an argument is empty
+	struct Slot {
+		size_t hash = 0;
+		std::string_view key;
+		const Argument* argument = nullptr;
+	};
+	std::list<Argument> arguments;
+	mutable std::vector<Slot> slots;
+	mutable bool indexed = false;
+	// prefix tree of keys of prefixed arguments which is built along with the index
+	mutable Trie prefixes;
+	// arguments by single character keys which is built along with the index
+	mutable std::array<const Argument*, 256> shorts = {};
+	// prefix tree of all keys which is built on first completion
+	mutable Trie trie;
+};
+
+// Stack of argument groups discovered during parsing, from the root one to the current one
+// Keys are searched in the groups by their own indexes, so pushing and popping of shared groups cost nothing
+class Argumentation
+{
+public:
+	void push(Group&&);
+	// Push @group which isn't owned, so it should outlive its popping
+	void push(const Group&);
+	void pop();
+	// Pop all the groups keeping allocated memory
+	void clear();
+	const Group& back() const;
+	bool empty() const;
+	size_t size() const;
+
+	// Find the nearest group, except the current (last) one, which has an argument with the key of @arg
+	// Returns the level of the group (0 is the root one) or -1 if there is no such group
+	// Unlike Group::find, disabled arguments are found as well
+	int recognize(const char* arg) const;
+
+private:
+	std::vector<const Group*> groups;
+	// groups pushed by values
+	std::list<Group> owned;
+};
+
+}
@@ -1,11 +1,20 @@
 #pragma once
 #include <set>
+#include <span>
+#include <thread>
+#include <exception>
 #include "Argument.h"
+#include "Group.h"
+#include "CompiledUsage.h"
+#include "UsageCache.h"
+#include "Tokenizer.h"
 
 namespace az::cli
 {
 
 // Command line interpreter
+// It keeps the state of a run, so an interpreter should be used by one thread at a time
+// Several threads can interpret their command lines at the same time against a shared @CompiledUsage
 class Interpreter
 {
 public:
@@ -13,18 +22,60 @@ public:
 		Options() {}
 		bool do_everything = false; // perform every parsed argument with action
 		bool ignore_unknown = false; // ignore unknown arguments
+		bool allow_abbreviations = false; // accept unique prefixes of keys, e.g: --verb for --verbose
+		bool allow_bundling = false; // accept bundled single character keys, e.g: -xvf for -x -v -f
+		unsigned parallel_actions = 0; // number of threads performing actions if do_everything
+		bool expand_files = false; // expand @path arguments into arguments of files at the paths
+		bool allow_descriptors = false; // let streamed arguments read values from file descriptors, e.g: &3
 		std::string need_help_string = "?"; // string that invokes NeedHelp error
 	};
 
 	// Construct and provide the interpreter by arguments vector and parsing options
 	Interpreter(const char** argv, int argc, const Options& = {});
 
+	// Prepare the interpreter for the next run dropping parsed actions of the previous one
+	// Allocated memory is kept, so one interpreter can handle many command lines; groups of a plain @Usage
+	//   are described and indexed again by each run, so CompiledUsage or UsageCache keep them warmed up
+	// Arguments vector is rewound or replaced by @args which should outlive the run
+	Interpreter& reset();
+	Interpreter& reset(std::span<const char*> args);
+
 	// Sets options.do_everything = true
 	Interpreter& doEverything(bool = true);
 
+	// Sets options.expand_files = true
+	// Arguments of the files are split like by Tokenizer and can refer to other files (see Cursor)
+	Interpreter& expandFiles(bool = true);
+
+	// Sets options.allow_descriptors = true
+	// Otherwise &N is taken as a usual value of a streamed argument, so a command line can't make the app
+	//   read descriptors it inherited for other purposes; - for stdin is always allowed (see Argument::streamed)
+	Interpreter& allowDescriptors(bool = true);
+
+	// Sets options.parallel_actions = @threads
+	// Actions are performed by the threads if there are more than one, otherwise one after another
+	// Actions are independent unless they're declared to be performed after others (see Argument::after)
+	// An action is not performed if any of its dependencies failed or they depend on each other
+	// The first error thrown by an action is rethrown after all the possible actions are performed
+	Interpreter& inParallel(unsigned threads = std::thread::hardware_concurrency());
+
 	// Sets options.ignore_unknown = true
 	Interpreter& ignoreUnknown(bool = true);
 
+	// Sets options.allow_abbreviations = true
+	// Throws Error::Code::AmbiguousArgument during parsing if a prefix is not unique
+	Interpreter& allowAbbreviations(bool = true);
+
+	// Sets options.allow_bundling = true
+	// A value can be attached to the last key of a bundle, e.g: -vofile for -v -o file
+	Interpreter& allowBundling(bool = true);
+
+	// Sets @configuration providing values of arguments which are not in the command line
+	// Values are taken in order: command line > environment variables > configuration > input > defaults
+	// nullptr drops the configuration
+	// The @configuration should outlive runs and can be shared by interpreters
+	Interpreter& configure(const Configuration*);
+
 	// Sets the string that invokes Error::Code::NeedHelp with printed usage (default: "?")
 	// Should be called before performing Interpreter::run
 	Interpreter& withNeedHelpString(const char*);
@@ -32,11 +83,48 @@ public:
 	// Sets callbacks to input values by @input and handle errors by @blame
 	Interpreter& interactively(const Argument::Interactor&);
 	Interpreter& interactively(const Argument::Interactor::Input& = {}, const Argument::Interactor::Blame& = {});
+	// Sets callbacks to input values asynchronously waiting for each value up to @timeout (0 means no limit)
+	// Values which are not input in time are taken by default
+	// The run blocks while waiting, so values should be input by another thread than the running one
+	Interpreter& interactively(const Argument::Interactor::AsyncInput&, std::chrono::milliseconds timeout,
+		const Argument::Interactor::Blame& = {});
 
 	// Parse arguments starting from @Argument and using @Usage to get arguments descriptions
 	// Fill @Context with parsed arguments values and perform parsed arguments with actions
 	int run(const Argument&, const Usage&);
 	int run(const Argument&, const Usage&, Context&);
+	// Does the same starting from the app argument of @CompiledUsage without calling its @Usage
+	int run(const CompiledUsage&);
+	int run(const CompiledUsage&, Context&);
+	// Does the same taking groups of arguments from @UsageCache, so @Usage isn't called again for met arguments
+	//   even by printing the help
+	int run(const Argument&, const UsageCache&);
+	int run(const Argument&, const UsageCache&, Context&);
+	// Does the same for @args instead of the arguments vector the interpreter is constructed with
+	int run(std::span<const char*> args, const Argument&, const Usage&, Context&);
+	int run(std::span<const char*> args, const CompiledUsage&, Context&);
+
+	// Outcome of an action performed by the last run
+	struct Outcome {
+		int id = 0; // id of the argument
+		int result = 0; // result of the action
+		bool performed = false; // whether the action is performed
+		std::exception_ptr error; // error thrown by the action
+	};
+	// Get outcomes of actions performed by the last run in order they're parsed
+	const std::vector<Outcome>& getOutcomes() const;
+
+	// Callback to get the time spent on interpretation of a @line
+	using Latency = std::function<void(const std::string& line, std::chrono::nanoseconds)>;
+	// Interpret each line of @stream as a command line of the app (without its name) till the end of @stream
+	// Lines are split by Tokenizer; errors are handled by @blame (or the interactor's one) and don't stop reading
+	// Help asked by a line is passed to @blame as Error::Code::NeedHelp and other exceptions as Error::Code::Unexpected
+	// The usage is compiled once, so every line is interpreted against warmed up groups
+	// Returns the result of the last interpreted line
+	int repl(std::istream& stream, const CompiledUsage&,
+		const Argument::Interactor::Blame& blame = {}, const Latency& = {});
+	int repl(std::istream& stream, const Argument&, const Usage&,
+		const Argument::Interactor::Blame& blame = {}, const Latency& = {});
 
 	// Print arguments starting from @Argument and using @Usage to get arguments descriptions
 	// It actually uses Printer class with default options
@@ -44,7 +132,13 @@ public:
 
 private:
 	// Perform parsing of all arguments in command line
-	bool parse(const Argument&, const Usage&, Context&);
+	// @arg is the value pos of the argument's key if it is already matched (see Argument::match)
+	bool parse(const Argument&, const Usage&, Context&, const char* arg = nullptr);
+	// Parse the current argv string as a bundle of single character keys of the current group
+	// Returns false if the string isn't a bundle or has an unknown key
+	bool parseBundle(const Usage&, Context&);
+	// Perform parsed actions by options.parallel_actions threads
+	void perform(const Context&);
 	// Acknowledge the existence of @arg among discovered arguments
 	bool recognize(const char* arg) const;
 
@@ -59,9 +153,22 @@ private:
 	// interactor for interactive mode
 	Argument::Interactor interactor;
 	// parsed arguments with action
-	std::list<Argument> actions;
+	std::vector<Argument> actions;
+	// outcomes of performed actions
+	std::vector<Outcome> outcomes;
+	// environment variables which are read once per run
+	Environment environment;
+	// splitter of lines into arguments for repl
+	Tokenizer tokenizer;
 	// discovered argument groups
-	std::list<std::list<Argument>> argumentation;
+	Argumentation argumentation;
+	// configuration files and their sections of discovered argument groups
+	const Configuration* configuration = nullptr;
+	std::vector<const Configuration::Section*> sections;
+	// compiled usage which is used instead of @Usage during its run
+	const CompiledUsage* compiled_usage = nullptr;
+	// cache of groups which is used instead of @Usage during its run
+	const UsageCache* usage_cache = nullptr;
 };
 
 }
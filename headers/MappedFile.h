@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+
+namespace az::cli
+{
+
+// File which is memory mapped privately, so its content can be changed in place without changing the file
+// The content is read into memory on platforms without mapping and for files which can't be mapped, e.g: pipes
+class MappedFile
+{
+public:
+	// Throws Error::Code::InvalidArgument if the file at @path can't be read
+	explicit MappedFile(const std::string& path);
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	char* data() const;
+	size_t size() const;
+	const std::string& path() const;
+
+private:
+	std::string file_path;
+	char* file_data = nullptr;
+	size_t file_size = 0;
+	bool mapped = false;
+	std::string content;
+};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <set>
 #include "Argument.h"
+#include "UsageCache.h"
 
 namespace az::cli
 {
@@ -25,6 +26,8 @@ public:
 
 	// Print the @Argument's hierarchy and return its id
 	int print(const Argument&, const Usage&, int margin = 0) const;
+	// Does the same taking groups of arguments from @UsageCache
+	int print(const Argument&, const UsageCache&, int margin = 0) const;
 
 	// Print the @Argument into the @stream indented by @margin spaces
 	void print(const Argument&, int margin = 0) const;
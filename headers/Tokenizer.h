@@ -0,0 +1,43 @@
+#pragma once
+#include <span>
+#include <string>
+#include <vector>
+#include <string_view>
+#include "Cursor.h"
+
+namespace az::cli
+{
+
+// Splitter of command lines into arguments with shell-like quoting:
+//  - arguments are separated by spaces, tabs and line breaks
+//  - 'single quoted' strings are taken as is
+//  - "double quoted" strings can contain escaped quotes and backslashes, e.g: \" and \\ inside
+//  - a backslash out of quotes escapes any next character
+// Arguments are written into one buffer which is reused, so splitting of many lines doesn't allocate memory
+//   once the buffer is big enough; long lines are scanned by SIMD instructions if they're available
+class Tokenizer
+{
+public:
+	// Split @line into zero terminated arguments which are valid till the next splitting
+	// @first is put before the arguments if it's given, e.g: the name of the app, to get a complete argv
+	// Throws Error::Code::InvalidEnd if a quote is not closed
+	std::span<const char*> split(std::string_view line, const char* first = nullptr);
+
+	// Get the arguments split from the last line (without @first)
+	std::span<const std::string_view> tokens() const;
+	// Get a cursor over the arguments of the last splitting (with @first)
+	Cursor cursor();
+
+	// Find the first of @chars in @line starting from @pos; returns the size of @line if there is none
+	static size_t find(std::string_view line, size_t pos, std::string_view chars);
+
+private:
+	// arguments separated by zero characters
+	std::string buffer;
+	// offsets of the arguments in the buffer
+	std::vector<size_t> offsets;
+	std::vector<std::string_view> views;
+	std::vector<const char*> args;
+};
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+namespace az::cli
+{
+
+class Argument;
+
+// Compact prefix tree of argument keys stored in a single array of nodes
+// Resolves a key, a unique prefix of keys or the longest key prefix of a string in O(key length)
+class Trie
+{
+public:
+	// Insert @key of @argument; the first inserted argument is kept if the key is duplicated
+	// The @key should outlive the trie
+	void insert(std::string_view key, const Argument* argument);
+
+	// Find the argument by whole @key
+	const Argument* find(std::string_view key) const;
+
+	// Find the only argument which has keys starting with @prefix
+	// Returns nullptr if there is no such argument or there are several ones;
+	//   in the latter case fills @candidates with their keys in alphabetical order
+	const Argument* complete(std::string_view prefix, std::vector<std::string_view>* candidates = nullptr) const;
+
+	// Find the argument with the longest key which @string starts with
+	// Sets @length to the length of the key if the argument is found
+	const Argument* findLongestPrefix(std::string_view string, size_t& length) const;
+
+	bool empty() const;
+
+private:
+	struct Node {
+		char label = 0;
+		uint32_t child = 0; // the first child; 0 means none, because the root can't be a child
+		uint32_t sibling = 0; // the next sibling with a greater label; 0 means none
+		const Argument* argument = nullptr; // argument which key ends at the node
+		const Argument* sole = nullptr; // argument of all keys in the subtree unless @several
+		bool several = false; // keys in the subtree belong to several arguments
+		std::string_view key; // the key which ends at the node
+	};
+	// Get the child of @node with @label; returns 0 if there is no such child
+	uint32_t child(uint32_t node, char label) const;
+	// Find the node of @prefix; returns 0 if there is no such prefix (or it is empty)
+	uint32_t walk(std::string_view prefix) const;
+	void collect(uint32_t node, std::vector<std::string_view>& keys) const;
+
+private:
+	std::vector<Node> nodes = std::vector<Node>(1);
+};
+
+}
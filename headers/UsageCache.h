@@ -0,0 +1,40 @@
+#pragma once
+#include <mutex>
+#include <unordered_map>
+#include "Argument.h"
+#include "Group.h"
+
+namespace az::cli
+{
+
+// Memo of argument groups described by @Usage which calls it once per argument on first request
+// Unlike CompiledUsage, only groups of met arguments are described, so it suits large and dynamic hierarchies
+// Groups are kept by ids of their parent arguments, because @Usage tells a group by the parent argument only,
+//   so an argument met at several paths of the hierarchy is described once
+// The cache can be shared by interpreters and printers of several threads; groups are indexed as they're made
+// @Usage is called without locking the cache, so threads meeting a new argument at once may describe it
+//   each (only one group is kept) and @Usage may request groups of the cache itself
+class UsageCache
+{
+public:
+	explicit UsageCache(const Usage&);
+
+	// Get the group of arguments of @argument calling @Usage for it on first request
+	const Group& group(const Argument& argument) const;
+	// Get @Usage returning copies of the cached groups, e.g: for printing
+	Usage usage() const;
+
+	// Forget the group of the argument with @id or all the groups, so @Usage is called for them again
+	//   e.g: if @Usage describes arguments depending on a changed state
+	// The forgotten groups shouldn't be in use by runs or printing at the time
+	void invalidate(int id);
+	void invalidate();
+
+private:
+	Usage describe;
+	mutable std::mutex mutex;
+	// groups of arguments by ids of their parent arguments
+	mutable std::unordered_map<int, Group> groups;
+};
+
+}
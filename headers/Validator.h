@@ -1,5 +1,8 @@
 #pragma once
 #include <map>
+#include <memory>
+#include <vector>
+#include <optional>
 #include <ostream>
 #include "Value.h"
 
@@ -9,12 +12,50 @@ namespace az::cli
 enum class Rule {
 	TYPE, UNIT, MIN, MAX, NONEMPTY, PATTERN, GLOSSARY,
 	NO_DUPLICATES_OF, NO_REPEATS_OF, CANNOT_START_WITH, CANNOT_END_WITH,
-	TRIM, PREFIX, SUFFIX, LOWER_CASE, UPPER_CASE
+	TRIM, PREFIX, SUFFIX, LOWER_CASE, UPPER_CASE, CACHE
 };
 
 class Validator
 {
 public:
+	// Incremental checker of a string value which is fed by chunks
+	// Keeps the state of characters and length rules between chunks, so a value
+	//   is checked with bounded memory; though a value is buffered entirely
+	//   if there are rules that require the whole one (pattern, glossary, number)
+	// Amending rules are not applied to the fed value
+	class Stream
+	{
+	public:
+		// Checks the next chunk of the value; a multibyte character can be split between chunks
+		// Throws the same errors as Validator::check does, but without the value
+		Stream& feed(const char* data, size_t size);
+		Stream& feed(const std::string& chunk);
+		// Checks the rules which need the end of the value
+		bool finish();
+		// Gets the number of characters fed so far
+		uint64_t length() const;
+	private:
+		friend class Validator;
+		Stream(const Validator&, bool whole);
+		void feed(wchar_t character);
+	private:
+		const Validator& validator;
+		std::string buffer;
+		bool buffering = false;
+		std::wstring no_duplicates_of;
+		std::wstring no_repeats_of;
+		std::wstring cannot_start_with;
+		std::wstring cannot_end_with;
+		std::vector<bool> duplicates;
+		std::optional<uint64_t> min_length;
+		std::optional<uint64_t> max_length;
+		uint64_t characters = 0;
+		wchar_t last_character = 0;
+		// incomplete UTF-8 character split between chunks
+		wchar_t partial_character = 0;
+		int partial_octets = 0;
+	};
+
 	// Overrides its rules by @Validator's
 	Validator& operator+=(const Validator&);
 
@@ -71,6 +112,9 @@ public:
 	Validator& lower_case();
 	// Makes a string upper cased
 	Validator& upper_case();
+	// Memoizes results of validate() for up to @capacity recently used raw strings
+	// The cache is renewed by any following rule, so copies of the validator with other rules don't share it
+	Validator& cached(size_t capacity = 64);
 
 	// Prints the validation details
 	virtual void print(std::ostream& stream, const Value& /*default value*/) const;
@@ -80,6 +124,17 @@ public:
 	virtual bool check(const std::string& source) const;
 	// Converts the @source string into the @Value according to rules
 	virtual Value apply(const std::string& source) const;
+	// Does amend, check and apply of the @raw string at once
+	// Throws Error::Code::InvalidValue if the string is not valid
+	Value validate(const char* raw) const;
+	// Starts incremental checking of a value; the validator should outlive the stream
+	Stream stream() const;
+	// Checks if a value can be checked by stream() without buffering
+	// Should be overridden to return false by validators which override check()
+	virtual bool isStreamable() const;
+	// Checks if results of validate() can be memoized
+	// Should be overridden to return false by validators which results depend on something but rules
+	virtual bool isCacheable() const;
 	// Checks if the @string can be converted and equal to the @Value
 	static bool match(const std::string&, const Value&);
 protected:
@@ -88,7 +143,13 @@ protected:
 	// Gets the @rule's value
 	Value get(Rule rule) const;
 private:
+	// Drops memoized results after the rules are changed
+	Validator& changed();
+
 	std::map<Rule, Value> rules;
+	// memoized results of validate() shared by copies of the validator and guarded for concurrent use
+	struct Cache;
+	std::shared_ptr<Cache> cache;
 };
 
 Validator evaluate();
@@ -1,6 +1,7 @@
 #pragma once
 #include <list>
 #include <string>
+#include <string_view>
 #include <ostream>
 
 namespace az::cli
@@ -35,6 +36,7 @@ public:
 	Value(wchar_t character) : Value(std::wstring(1, character)) {}
 	Value(const std::string& string_value) : Value(string_value.c_str()) {}
 	Value(const std::wstring& string_value) : Value(string_value.c_str()) {}
+	Value(std::string_view string_value);
 	Value(const std::initializer_list<Value>& list);
 	~Value();
 	void reset(Type type = Type::None);
@@ -4,19 +4,167 @@
 #include <string.h>
 #include "Error.h"
 #include <numeric>
+#include <algorithm>
+#include <charconv>
+#include <cerrno>
+#include <deque>
+#include <utility>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <condition_variable>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace az::cli
 {
 
+namespace
+{
+
+// Make a string which is equal for equal values only, e.g: to hash values
+void fingerprint(const Value& value, std::string& print)
+{
+	print += char('0' + int(value.getType()));
+	if (value.isArray()) {
+		for (const auto& item : value) {
+			fingerprint(item, print);
+		}
+		print += ']';
+	}
+	else {
+		print += value.asString();
+		print += '\0';
+	}
+}
+
+// Prints of values passed by a unique argument
+using Fingerprints = std::unordered_set<std::string>;
+
+// Returns false if @value is already passed
+bool pass(Fingerprints& passed, const Value& value)
+{
+	std::string print;
+	fingerprint(value, print);
+	return passed.insert(std::move(print)).second;
+}
+
+}
+
+struct Argument::Consumption
+{
+	Consumption(const Each& each, size_t queue_size)
+		: each(each), queue_size(queue_size) {}
+	~Consumption()
+	{
+		try {
+			finish();
+		}
+		catch (...) {
+			// the error is lost if values are never provided
+		}
+	}
+
+	// Returns false if @value is already consumed
+	bool unique(const Value& value)
+	{
+		std::lock_guard lock(mutex);
+		return pass(passed, value);
+	}
+
+	void consume(const Value& value)
+	{
+		if (!queue_size) {
+			each(value);
+			return;
+		}
+		std::unique_lock lock(mutex);
+		if (!worker.joinable()) {
+			worker = std::thread([this] { work(); });
+		}
+		changed.wait(lock, [this] { return queue.size() < queue_size || error; });
+		if (!error) {
+			queue.push_back(value);
+			changed.notify_all();
+		}
+	}
+
+	void work()
+	{
+		std::unique_lock lock(mutex);
+		for (;;) {
+			changed.wait(lock, [this] { return !queue.empty() || finishing; });
+			if (queue.empty()) {
+				break;
+			}
+			auto value = std::move(queue.front());
+			queue.pop_front();
+			changed.notify_all();
+			lock.unlock();
+			try {
+				each(value);
+			}
+			catch (...) {
+				lock.lock();
+				error = std::current_exception();
+				queue.clear();
+				changed.notify_all();
+				continue;
+			}
+			lock.lock();
+		}
+	}
+
+	// Wait till the queued values are consumed and rethrow the error of the consumer
+	void finish()
+	{
+		std::unique_lock lock(mutex);
+		if (!worker.joinable()) {
+			return;
+		}
+		finishing = true;
+		changed.notify_all();
+		lock.unlock();
+		worker.join();
+		lock.lock();
+		finishing = false;
+		if (auto failure = std::exchange(error, nullptr)) {
+			std::rethrow_exception(failure);
+		}
+	}
+
+	Each each;
+	size_t queue_size;
+	std::mutex mutex;
+	std::condition_variable changed;
+	std::deque<Value> queue;
+	std::thread worker;
+	bool finishing = false;
+	std::exception_ptr error;
+	Fingerprints passed;
+};
+
 Argument::Argument(int id, const std::list<std::string>& keys, const std::string& description)
+	: identifier(id)
 {
-	attributes[Attribute::ID] = id;
+	auto names = std::make_shared<Names>();
 	for (const auto& key : keys) {
 		if (!key.empty()) {
-			attributes[Attribute::KEYS].append(key);
+			names->keys.emplace_back(key);
+			if (key.size() > names->longest_key.size()) {
+				names->longest_key = key;
+			}
 		}
 	}
-	attributes[Attribute::DESCRIPTION] = description;
+	if (!names->keys.empty()) {
+		names->keys_string = std::accumulate(std::next(names->keys.begin()), names->keys.end(), names->keys.front().name,
+			[](std::string sum, const Key& key) { return std::move(sum) + ", " + key.name; });
+	}
+	names->description = description;
+	this->names = std::move(names);
 
 	if (keys.empty()) {
 		hidden();
@@ -31,7 +179,7 @@ Argument::Argument(int id, const std::string& description)
 Argument& Argument::with_value(const Value& value)
 {
 	validator.reset();
-	attributes[Attribute::CERTAIN_VALUE] = value;
+	certain_value = std::make_shared<const Value>(value);
 	return *this;
 }
 
@@ -40,9 +188,15 @@ Argument& Argument::with_no_value()
 	return with_value(Value::Type::None);
 }
 
+Argument& Argument::from_env(const std::string& name)
+{
+	variable_name = std::make_shared<const std::string>(name);
+	return *this;
+}
+
 Argument& Argument::by_default(const Value& value)
 {
-	attributes[Attribute::DEFAULT_VALUE] = value;
+	default_value = std::make_shared<const Value>(value);
 	return *this;
 }
 
@@ -58,44 +212,87 @@ Argument& Argument::with_action(const Action::Full& act)
 	return *this;
 }
 
-Argument& Argument::required(bool whether)
+Argument& Argument::after(int id)
 {
-	if (whether) {
-		attributes[Attribute::REQUIRED];
-	}
+	dependencies.push_back(id);
 	return *this;
 }
 
-Argument& Argument::multiple(bool whether)
+Argument& Argument::setFlag(Flag flag, bool whether)
 {
 	if (whether) {
-		attributes[Attribute::MULTIPLE];
+		flags |= flag;
+	} else {
+		flags &= ~flag;
 	}
 	return *this;
 }
 
+bool Argument::hasFlag(Flag flag) const
+{
+	return (flags & flag) != 0;
+}
+
+Argument& Argument::required(bool whether)
+{
+	return setFlag(REQUIRED, whether);
+}
+
+Argument& Argument::multiple(bool whether)
+{
+	return setFlag(MULTIPLE, whether);
+}
+
 Argument& Argument::disabled(bool whether)
 {
-	if (whether) {
-		// TODO: store a disabling reason string that'll be thrown in a cli::Error::help()
-		attributes[Attribute::DISABLED];
-	}
-	return *this;
+	// TODO: store a disabling reason string that'll be thrown in a cli::Error::help()
+	return setFlag(DISABLED, whether);
 }
 
 Argument& Argument::unique(bool whether)
 {
-	if (whether) {
-		attributes[Attribute::UNIQUE];
-	}
-	return *this;
+	return setFlag(UNIQUE, whether);
 }
 
 Argument& Argument::hidden(bool whether)
 {
-	if (whether) {
-		attributes[Attribute::HIDDEN];
-	}
+	return setFlag(HIDDEN, whether);
+}
+
+Argument& Argument::prefixed(bool whether)
+{
+	return setFlag(PREFIXED, whether);
+}
+
+Argument& Argument::arity(uint32_t min, uint32_t max)
+{
+	min_values = min;
+	max_values = std::max(min, max);
+	return *this;
+}
+
+Argument& Argument::counting(bool whether)
+{
+	return setFlag(COUNTING, whether);
+}
+
+Argument& Argument::streamed(char delimiter)
+{
+	this->delimiter = delimiter;
+	setFlag(MULTIPLE, true);
+	return setFlag(STREAMED, true);
+}
+
+Argument& Argument::on_each(const Each& each, size_t queue_size)
+{
+	consumer = each;
+	this->queue_size = queue_size;
+	return *this;
+}
+
+Argument& Argument::paired(char separator)
+{
+	this->separator = separator;
 	return *this;
 }
 
@@ -106,28 +303,42 @@ bool Argument::needValue() const
 
 bool Argument::isRequired() const
 {
-	return attributes.contains(Attribute::REQUIRED);
+	return hasFlag(REQUIRED);
 }
 
 bool Argument::isMultiple() const
 {
-	return attributes.contains(Attribute::MULTIPLE);
+	return hasFlag(MULTIPLE);
 }
 
 bool Argument::isEnabled() const
 {
-	return !attributes.contains(Attribute::DISABLED);
+	return !hasFlag(DISABLED);
 }
 
 bool Argument::isUnique() const
 {
-	return attributes.contains(Attribute::UNIQUE);
+	return hasFlag(UNIQUE);
 }
 
 bool Argument::isHidden() const
 {
-	return attributes.contains(Attribute::HIDDEN) ||
-		attributes.contains(Attribute::DISABLED);
+	return hasFlag(HIDDEN) || hasFlag(DISABLED);
+}
+
+bool Argument::isPrefixed() const
+{
+	return hasFlag(PREFIXED);
+}
+
+bool Argument::isCounting() const
+{
+	return hasFlag(COUNTING);
+}
+
+bool Argument::isStreamed() const
+{
+	return hasFlag(STREAMED);
 }
 
 bool Argument::hasAction() const
@@ -135,25 +346,30 @@ bool Argument::hasAction() const
 	return action;
 }
 
+const std::vector<int>& Argument::getDependencies() const
+{
+	return dependencies;
+}
+
 bool Argument::isValuable() const
 {
-	return validator || hasDefaultValue() || hasCertainValue();
+	return validator || hasDefaultValue() || hasCertainValue() || binding || consumer || isCounting();
 }
 
 bool Argument::hasDefaultValue() const
 {
-	return attributes.contains(Attribute::DEFAULT_VALUE);
+	return default_value != nullptr;
 }
 
 bool Argument::hasCertainValue() const
 {
-	return attributes.contains(Attribute::CERTAIN_VALUE);
+	return certain_value != nullptr;
 }
 
 Value Argument::getDefaultValue() const
 {
 	if (hasDefaultValue()) {
-		return attributes.at(Attribute::DEFAULT_VALUE);
+		return *default_value;
 	}
 	return {};
 }
@@ -170,54 +386,55 @@ Value Argument::getValidatedDefaultValue() const
 Value Argument::getCertainValue() const
 {
 	if (hasCertainValue()) {
-		return attributes.at(Attribute::CERTAIN_VALUE);
+		return *certain_value;
 	}
 	return {};
 }
 
 std::string Argument::getDescription() const
 {
-	if (attributes.contains(Attribute::DESCRIPTION)) {
-		return attributes.at(Attribute::DESCRIPTION);
+	if (names) {
+		return names->description;
 	}
 	return {};
 }
 
 int Argument::id() const
 {
-	return attributes.at(Attribute::ID);
+	return identifier;
 }
 
 std::list<std::string> Argument::getKeys() const
 {
 	std::list<std::string> keys;
-	if (attributes.contains(Attribute::KEYS)) {
-		attributes.at(Attribute::KEYS).toContainer(std::back_inserter(keys));
+	if (names) {
+		for (const auto& key : names->keys) {
+			keys.push_back(key.name);
+		}
 	}
 	return keys;
 }
 
+const std::vector<Argument::Key>& Argument::getHashedKeys() const
+{
+	static const std::vector<Key> no_keys;
+	return names ? names->keys : no_keys;
+}
+
 std::string Argument::getKeysString() const
 {
-	auto keys = getKeys();
-	if (!keys.empty()) {
-		return std::accumulate(std::next(keys.begin()), keys.end(), keys.front(),
-			[](std::string sum, const std::string& name) { return std::move(sum) + ", " + name; });
+	if (names) {
+		return names->keys_string;
 	}
 	return {};
 }
 
 std::string Argument::getLongestKey() const
 {
-	std::string longest_key;
-	if (attributes.contains(Attribute::KEYS)) {
-		for (const auto& key : attributes.at(Attribute::KEYS)) {
-			if (key.size() > longest_key.size()) {
-				longest_key = key.asString();
-			}
-		}
+	if (names) {
+		return names->longest_key;
 	}
-	return longest_key;
+	return {};
 }
 
 void Argument::getValidation(std::ostream& stream) const
@@ -267,11 +484,7 @@ bool Argument::validate(const char* arg, Value& value) const
 			throw Error(Error::Code::InvalidValue);
 		}
 		if (validator) {
-			auto source = validator->amend(arg);
-			if (!validator->check(source)) {
-				throw Error(Error::Code::InvalidValue).value(source);
-			}
-			value = validator->apply(source);
+			value = validator->validate(arg);
 		}
 	}
 	catch (Error& error) {
@@ -290,7 +503,17 @@ bool Argument::input(const Interactor& interactor, Value& value) const
 {
 	while (interactor && !isHidden()) {
 		// TODO: input multiply if argument is multiple
-		auto line = interactor.input(*this);
+		std::string line;
+		if (interactor.async_input) {
+			auto future = interactor.async_input(*this);
+			if (interactor.timeout.count() && future.wait_for(interactor.timeout) != std::future_status::ready) {
+				break;
+			}
+			line = future.get();
+		}
+		else {
+			line = interactor.input(*this);
+		}
 		if (line.empty()) {
 			break;
 		}
@@ -308,44 +531,123 @@ bool Argument::input(const Interactor& interactor, Value& value) const
 
 const char* Argument::match(const char* arg) const
 {
-	if (attributes.count(Attribute::KEYS)) {
-		// TODO: assuming a key may have an assignment character
-		// firstly compare a whole key with an argument string
-		// then check if an assignment is at key-size position
-		auto assignment_pos = strchr(arg, '=');
-		std::string key = assignment_pos ? std::string(arg, assignment_pos - arg) : std::string(arg);
-		if (attributes.at(Attribute::KEYS).contains(key)) {
-			return assignment_pos ? ++assignment_pos : arg;
-		}
+	// TODO: assuming a key may have an assignment character
+	// firstly compare a whole key with an argument string
+	// then check if an assignment is at key-size position
+	if (hasKey(getKeyOf(arg))) {
+		return getValueOf(arg);
 	}
 	return nullptr;
 }
 
-bool Argument::parse(Cursor& cursor, Context& context) const
+bool Argument::hasKey(std::string_view key) const
+{
+	if (names) {
+		for (const auto& own_key : names->keys) {
+			if (own_key == key) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool Argument::hasKey(std::string_view key, size_t hash) const
+{
+	if (names) {
+		for (const auto& own_key : names->keys) {
+			if (own_key.hash == hash && own_key == key) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+std::string_view Argument::getKeyOf(const char* arg)
+{
+	std::string_view key(arg);
+	return key.substr(0, key.find('='));
+}
+
+const char* Argument::getValueOf(const char* arg)
+{
+	auto key = getKeyOf(arg);
+	return arg[key.size()] == '=' ? arg + key.size() + 1 : arg;
+}
+
+size_t Argument::hash(std::string_view key)
+{
+	return std::hash<std::string_view>()(key);
+}
+
+bool Argument::parse(Cursor& cursor, Context& context, const Recognizer& recognize) const
 {
 	// don't match the first argument because it's a name of the app (can be with a path)
 	// TODO: maybe should save the path of app to the @context
 	auto arg = cursor.pos() > 0 ? match(cursor.arg()) : cursor.arg();
-	if (!arg) {
-		return false;
-	}
+	return arg && parse(arg, cursor, context, recognize);
+}
+
+bool Argument::parse(const char* arg, Cursor& cursor, Context& context, const Recognizer& recognize) const
+{
 	if (!isEnabled()) {
-		// TODO: throw Error(Error::Code::DisabledArgument).argument(arg).help(attributes.at(Attribute::DISABLED))
+		// TODO: throw Error(Error::Code::DisabledArgument).argument(arg).help(disabling reason)
 		return false;
 	}
+	if (consumer && !isMultiple() && context.has(id())) {
+		// consumed values aren't stored, so the argument is checked once per parse instead of per value
+		throw Error(Error::Code::Multiple).argument(getLongestKey());
+	}
 	Value value;
-	if (needValue()) {
-		if (arg != cursor.arg()) {
-			validate(arg, value);
-		} else if (++cursor) {
-			validate(cursor.arg(), value);
-		} else {
-			throw Error(Error::Code::NeedValue).argument(arg).help(getValidation());
-		}
-	} else if (hasCertainValue()) {
+	auto key = cursor.arg();
+	++cursor; // forward the cursor to the next argument
+
+	if (needValue() && min_values == 1 && max_values == 1) {
+		if (arg == key) {
+			if (cursor.eol()) {
+				throw Error(Error::Code::NeedValue).argument(arg).help(getValidation());
+			}
+			arg = cursor.arg();
+			++cursor;
+		}
+		if (isStreamed() && stream(arg, cursor, context)) {
+			return true;
+		}
+		value = take(arg);
+	}
+	else if (needValue()) {
+		// consume values in bulk till the limit or a recognized argument
+		// each value goes straight to the consumer if there is one
+		value.reset(Value::Type::Array);
+		uint32_t taken = 0;
+		auto collect = [&](const char* arg) {
+			if (consumer) {
+				store(take(arg), context);
+			}
+			else {
+				value.append(take(arg));
+			}
+			taken++;
+		};
+		if (arg != key) {
+			collect(arg);
+		}
+		while (taken < max_values && !cursor.eol() && !(recognize && recognize(cursor.arg()))) {
+			collect(cursor.arg());
+			++cursor;
+		}
+		if (taken < min_values) {
+			throw Error(Error::Code::TooFew).argument(getLongestKey())
+				.value(std::to_string(taken)).help(std::to_string(min_values));
+		}
+		if (consumer) {
+			return true;
+		}
+	}
+	else if (hasCertainValue()) {
 		value = getCertainValue();
 	}
-	++cursor; // forward the cursor to the next argument
 
 	if (isValuable()) {
 		store(value, context);
@@ -353,11 +655,160 @@ bool Argument::parse(Cursor& cursor, Context& context) const
 	return true;
 }
 
-void Argument::provideValue(const Interactor& interactor, Context& context) const
+Value Argument::take(const char* arg) const
+{
+	Value value;
+	auto separator_pos = separator ? strchr(arg, separator) : nullptr;
+	if (separator_pos) {
+		Value paired_value;
+		validate(separator_pos + 1, paired_value);
+		value = {Value(std::string_view(arg, separator_pos - arg)), paired_value};
+	} else if (separator) {
+		value = {arg, Value()};
+	} else {
+		validate(arg, value);
+	}
+	return value;
+}
+
+bool Argument::stream(const char* arg, const Cursor& cursor, Context& context) const
+{
+	int source = -1;
+	if (arg[0] == '-' && !arg[1]) {
+		source = 0;
+	}
+	else if (arg[0] == '&' && cursor.allowsDescriptors()) {
+		auto end = arg + strlen(arg);
+		auto result = std::from_chars(arg + 1, end, source);
+		if (result.ec != std::errc() || result.ptr != end || result.ptr == arg + 1) {
+			return false;
+		}
+	}
+	else {
+		return false;
+	}
+	// values split by chunks are gathered in @pending, the others are terminated in place
+	const size_t chunk_size = 64 * 1024;
+	std::vector<char> chunk(chunk_size);
+	std::string pending;
+	auto deliver = [&](char* value, size_t size) {
+		if (delimiter == '\n' && size && value[size - 1] == '\r') {
+			size--;
+		}
+		if (size) {
+			value[size] = 0;
+			store(take(value), context);
+		}
+	};
+	for (;;) {
+#if defined(_WIN32)
+		auto size = _read(source, chunk.data(), unsigned(chunk_size));
+#else
+		auto size = ::read(source, chunk.data(), chunk_size);
+#endif
+		if (size < 0 && errno == EINTR) {
+			continue;
+		}
+		if (size < 0) {
+			throw Error(Error::Code::InvalidValue).argument(getLongestKey()).value(arg).help("can't read the stream");
+		}
+		if (size == 0) {
+			break;
+		}
+		char* start = chunk.data();
+		char* end = start + size;
+		for (char* next; (next = static_cast<char*>(memchr(start, delimiter, end - start))); start = next + 1) {
+			if (pending.empty()) {
+				deliver(start, next - start);
+			}
+			else {
+				pending.append(start, next - start);
+				deliver(pending.data(), pending.size());
+				pending.clear();
+			}
+		}
+		pending.append(start, end - start);
+	}
+	// the last value may be not delimited
+	deliver(pending.data(), pending.size());
+	// the argument is passed even if the stream is empty
+	context[id()];
+	return true;
+}
+
+std::string Argument::getVariableName() const
+{
+	return variable_name ? *variable_name : std::string();
+}
+
+void Argument::provideValue(const Interactor& interactor, Context& context, const Environment* environment,
+	const Setting* setting) const
 {
+	if (consumer) {
+		// the consumption is over once the values of the argument are provided
+		if (auto consumption = std::static_pointer_cast<Consumption>(std::exchange(context.state(id()), nullptr))) {
+			consumption->finish();
+		}
+	}
 	if (!isValuable() || context.has(id())) {
 		return;
 	}
+	auto variable = variable_name && environment ? environment->find(*variable_name) : nullptr;
+	if (variable && !*variable) {
+		variable = nullptr; // an empty variable is taken as unset one, e.g: FOO= for a flag
+	}
+	if (isCounting()) {
+		// a counter is always provided; the variable tells the count, e.g: VERBOSITY=3 for -vvv
+		Value counter = hasDefaultValue() ? getDefaultValue() : Value(int64_t(0));
+		if (variable) {
+			int64_t count = 0;
+			auto end = variable + strlen(variable);
+			auto result = std::from_chars(variable, end, count);
+			if (result.ec != std::errc() || result.ptr != end || count < 0) {
+				throw Error(Error::Code::InvalidValue).argument(*variable_name).value(variable);
+			}
+			counter = count;
+		}
+		context[id()] = counter;
+		if (binding) {
+			binding(context[id()]);
+		}
+		return;
+	}
+	if (variable) {
+		if (needValue()) {
+			store(take(variable), context);
+		}
+		else {
+			bool passed = false;
+			try {
+				passed = bool(Value(variable));
+			}
+			catch (Error& error) {
+				error.argument(*variable_name);
+				throw;
+			}
+			if (passed) {
+				store(hasCertainValue() ? getCertainValue() : Value(), context);
+			}
+		}
+		return;
+	}
+	if (setting) {
+		try {
+			if (needValue()) {
+				store(take(setting->value), context);
+			}
+			else if (bool(Value(setting->value))) {
+				store(hasCertainValue() ? getCertainValue() : Value(), context);
+			}
+		}
+		catch (Error& error) {
+			error.argument(getKeysString()).location(*setting->file, setting->line);
+			throw;
+		}
+		return;
+	}
 	Value value;
 	if (needValue() && input(interactor, value)) {
 		store(value, context);
@@ -374,18 +825,66 @@ void Argument::provideValue(const Interactor& interactor, Context& context) cons
 
 void Argument::store(const Value& value, Context& context) const
 {
-	if (isMultiple()) {
-		if (isUnique() && context[id()].contains(value)) {
+	if (isCounting()) {
+		auto& counter = context[id()];
+		counter = int64_t(counter) + 1;
+		if (binding) {
+			binding(counter);
+		}
+		return;
+	}
+	if (consumer) {
+		auto& state = context.state(id());
+		if (!state) {
+			state = std::make_shared<Consumption>(consumer, queue_size);
+		}
+		auto& consumption = *std::static_pointer_cast<Consumption>(state);
+		if (isUnique() && !consumption.unique(value)) {
 			throw Error(Error::Code::DuplicateValue)
-				.argument(getLongestKey()).value(value.asString());
+				.argument(getLongestKey()).value(value.isArray() ? std::string() : value.asString());
+		}
+		consumption.consume(value);
+		context[id()];
+		return;
+	}
+	bool detached = hasFlag(DETACHED);
+	if (isMultiple()) {
+		if (isUnique()) {
+			// uniqueness is checked by a hash set of the run, so millions of streamed values aren't compared
+			//   one by one and detached values aren't kept
+			auto& state = context.state(id());
+			if (!state) {
+				auto passed = std::make_shared<Fingerprints>();
+				if (context.has(id()) && context[id()].isArray()) {
+					for (const auto& item : context[id()]) {
+						pass(*passed, item);
+					}
+				}
+				state = passed;
+			}
+			if (!pass(*std::static_pointer_cast<Fingerprints>(state), value)) {
+				throw Error(Error::Code::DuplicateValue)
+					.argument(getLongestKey()).value(value.isArray() ? std::string() : value.asString());
+			}
+		}
+		if (binding) {
+			binding(value);
+		}
+		if (detached) {
+			context[id()];
+		}
+		else {
+			context[id()].append(value);
 		}
-		context[id()].append(value);
 	}
 	else if (context.has(id())) {
 		throw Error(Error::Code::Multiple).argument(getLongestKey());
 	}
 	else {
-		context[id()] = value;
+		if (binding) {
+			binding(value);
+		}
+		context[id()] = detached ? Value() : value;
 	}
 }
 
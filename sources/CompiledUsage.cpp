@@ -0,0 +1,47 @@
+#include "CompiledUsage.h"
+
+namespace az::cli
+{
+
+CompiledUsage::CompiledUsage(const Argument& app, const Usage& usage)
+	: app(app)
+{
+	compile(this->app, usage);
+	// the empty group is searched by threads as well
+	no_group.compile();
+}
+
+void CompiledUsage::compile(const Argument& argument, const Usage& usage)
+{
+	// an argument can be met several times in the hierarchy but it's described once
+	if (groups.count(argument.id())) {
+		return;
+	}
+	// references to elements of the map stay valid while it grows
+	auto& group = groups.emplace(argument.id(), Group(usage(argument))).first->second;
+	group.compile();
+	for (const auto& sub_argument : group) {
+		compile(sub_argument, usage);
+	}
+}
+
+const Argument& CompiledUsage::root() const
+{
+	return app;
+}
+
+const Group& CompiledUsage::group(const Argument& argument) const
+{
+	auto found = groups.find(argument.id());
+	return found != groups.end() ? found->second : no_group;
+}
+
+Usage CompiledUsage::usage() const
+{
+	return [this](const Argument& argument) {
+		const auto& arguments = group(argument);
+		return std::list<Argument>(arguments.begin(), arguments.end());
+	};
+}
+
+}
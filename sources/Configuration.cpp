@@ -0,0 +1,117 @@
+#include "Configuration.h"
+#include "Argument.h"
+#include "Error.h"
+
+namespace az::cli
+{
+
+namespace
+{
+
+const std::string_view blanks = " \t\r";
+
+std::string_view trim(std::string_view string)
+{
+	auto start = string.find_first_not_of(blanks);
+	if (start == std::string_view::npos) {
+		// an empty string still refers to the place where it's found
+		return string.substr(string.size());
+	}
+	return string.substr(start, string.find_last_not_of(blanks) - start + 1);
+}
+
+// key of @argument as it's written in files, e.g: verbose for --verbose
+std::string_view nameOf(std::string_view key)
+{
+	return key.substr(std::min(key.find_first_not_of('-'), key.size()));
+}
+
+}
+
+const Setting* Configuration::Section::find(const Argument& argument) const
+{
+	for (const auto& key : argument.getHashedKeys()) {
+		auto found = settings.find(nameOf(key.name));
+		if (found != settings.end()) {
+			return &found->second;
+		}
+	}
+	return nullptr;
+}
+
+const Configuration::Section* Configuration::Section::section(const Argument& argument) const
+{
+	for (const auto& key : argument.getHashedKeys()) {
+		auto found = sections.find(nameOf(key.name));
+		if (found != sections.end()) {
+			return found->second.get();
+		}
+	}
+	return nullptr;
+}
+
+Configuration& Configuration::load(const std::string& path)
+{
+	auto& file = files.emplace_back(path);
+	char* data = file.data();
+	std::string_view content(data, file.size());
+	Section* section = &top;
+	uint32_t line = 0;
+	for (size_t start = 0; start < content.size(); ) {
+		size_t end = std::min(content.find('\n', start), content.size());
+		auto text = trim(content.substr(start, end - start));
+		line++;
+		start = end + 1;
+		if (text.empty() || text[0] == '#' || text[0] == ';') {
+			continue;
+		}
+		if (text.front() == '[') {
+			if (text.back() != ']' || trim(text.substr(1, text.size() - 2)).empty()) {
+				throw Error(Error::Code::InvalidValue).value(std::string(text)).help("malformed section")
+					.location(file.path(), line);
+			}
+			// dotted names are nested sections
+			auto names = trim(text.substr(1, text.size() - 2));
+			section = &top;
+			for (size_t dot = 0; dot != std::string_view::npos; ) {
+				dot = names.find('.');
+				auto& nested = section->sections[trim(names.substr(0, dot))];
+				if (!nested) {
+					nested = std::make_unique<Section>();
+				}
+				section = nested.get();
+				names = dot != std::string_view::npos ? names.substr(dot + 1) : std::string_view();
+			}
+			continue;
+		}
+		auto equal = text.find('=');
+		auto key = trim(text.substr(0, equal));
+		if (equal == std::string_view::npos || key.empty()) {
+			throw Error(Error::Code::InvalidValue).value(std::string(text)).help("expected key = value")
+				.location(file.path(), line);
+		}
+		auto value = trim(text.substr(equal + 1));
+		if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front()) {
+			value = value.substr(1, value.size() - 2);
+		}
+		Setting setting = {nullptr, &file.path(), line};
+		size_t value_end = value.data() + value.size() - data;
+		if (value_end < content.size()) {
+			// the value is followed by a blank, a quote or a line end which aren't needed anymore
+			data[value_end] = 0;
+			setting.value = value.data();
+		}
+		else {
+			setting.value = copies.emplace_back(value).c_str();
+		}
+		section->settings.insert_or_assign(key, setting);
+	}
+	return *this;
+}
+
+const Configuration::Section& Configuration::root() const
+{
+	return top;
+}
+
+}
@@ -0,0 +1,148 @@
+#include "Cursor.h"
+#include "Tokenizer.h"
+#include "Error.h"
+#include "MappedFile.h"
+#include <string>
+#include <algorithm>
+
+namespace az::cli
+{
+
+namespace
+{
+
+// response files can't refer to each other deeper
+const size_t max_nesting = 64;
+const std::string_view delimiters = std::string_view(" \t\r\n\0", 5);
+const std::string_view specials = std::string_view(" \t\r\n\0'\"\\", 8);
+
+}
+
+struct Cursor::File
+{
+	explicit File(const char* path)
+		: mapping(path) {}
+
+	MappedFile mapping;
+	// splitters of args which are unquoted or can't be terminated in the file
+	// they take turns, so the previous arg stays valid while the current one is split
+	Tokenizer tokenizers[2];
+	unsigned turn = 0;
+};
+
+Cursor& Cursor::expandFiles(bool whether)
+{
+	expand_files = whether;
+	expand();
+	return *this;
+}
+
+void Cursor::rewind()
+{
+	arg_index = 0;
+	position = 0;
+	frames.clear();
+	passed.reset();
+}
+
+Cursor& Cursor::operator++()
+{
+	position++;
+	passed = frames.empty() ? nullptr : frames.back().file;
+	// files which are passed entirely are dropped along with their @path args
+	while (!frames.empty() && !advance(frames.back())) {
+		frames.pop_back();
+	}
+	if (frames.empty()) {
+		arg_index++;
+	}
+	expand();
+	return *this;
+}
+
+void Cursor::expand()
+{
+	// the first arg is the name of the app
+	while (expand_files && position > 0 && !eol() && arg()[0] == '@') {
+		if (frames.size() >= max_nesting) {
+			throw Error(Error::Code::InvalidArgument).argument(arg()).help("too deep nesting of files");
+		}
+		Frame frame;
+		try {
+			frame.file = std::make_shared<File>(arg() + 1);
+		}
+		catch (Error& error) {
+			error.argument(arg());
+			throw;
+		}
+		if (advance(frame)) {
+			frames.push_back(std::move(frame));
+			continue;
+		}
+		// an empty file is passed at once
+		while (!frames.empty() && !advance(frames.back())) {
+			frames.pop_back();
+		}
+		if (frames.empty()) {
+			arg_index++;
+		}
+	}
+}
+
+bool Cursor::advance(Frame& frame)
+{
+	auto& file = *frame.file;
+	std::string_view content(file.mapping.data(), file.mapping.size());
+	size_t start = frame.next;
+	while (start < content.size() && delimiters.find(content[start]) != std::string_view::npos) {
+		frame.line += content[start] == '\n';
+		start++;
+	}
+	if (start == content.size()) {
+		frame.arg = nullptr;
+		return false;
+	}
+	// find the end of the arg skipping quoted and escaped characters
+	bool plain = true;
+	size_t end = start;
+	while ((end = Tokenizer::find(content, end, specials)) < content.size()) {
+		char special = content[end];
+		if (delimiters.find(special) != std::string_view::npos) {
+			break;
+		}
+		plain = false;
+		if (special == '\\') {
+			end = std::min(end + 2, content.size());
+			continue;
+		}
+		// skip the quoted string; the escaped quotes are skipped inside double quoted one
+		for (end++; end < content.size() && content[end] != special; end++) {
+			if (special == '"' && content[end] == '\\') {
+				end++;
+			}
+		}
+		end = std::min(end + 1, content.size());
+	}
+	frame.next = end;
+	if (plain && end < content.size()) {
+		// terminating the arg in place is harmless for the other cursors, because zero is a delimiter too
+		frame.line += content[end] == '\n';
+		file.mapping.data()[end] = 0;
+		frame.arg = file.mapping.data() + start;
+		return true;
+	}
+	file.turn ^= 1;
+	try {
+		auto args = file.tokenizers[file.turn].split(content.substr(start, end - start));
+		frame.arg = args.empty() ? "" : args[0];
+	}
+	catch (Error& error) {
+		error.argument("@" + file.mapping.path()).location(file.mapping.path(), frame.line);
+		throw;
+	}
+	// quoted args can span lines
+	frame.line += std::count(content.begin() + start, content.begin() + end, '\n');
+	return true;
+}
+
+}
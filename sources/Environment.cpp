@@ -0,0 +1,41 @@
+#include "Environment.h"
+#include <string.h>
+#if defined(_WIN32)
+#include <stdlib.h>
+#define environ _environ
+#else
+#include <unistd.h>
+extern char** environ;
+#endif
+
+namespace az::cli
+{
+
+void Environment::index() const
+{
+	variables.clear();
+	for (auto variable = environ; variable && *variable; variable++) {
+		auto separator = strchr(*variable, '=');
+		if (separator) {
+			// the first variable wins like getenv does
+			variables.emplace(std::string_view(*variable, separator - *variable), separator + 1);
+		}
+	}
+	indexed = true;
+}
+
+const char* Environment::find(std::string_view name) const
+{
+	if (!indexed) {
+		index();
+	}
+	auto found = variables.find(name);
+	return found != variables.end() ? found->second : nullptr;
+}
+
+void Environment::clear()
+{
+	indexed = false;
+}
+
+}
@@ -26,6 +26,8 @@ const std::map<Error::Code,const char*> error_codes_to_strings = {
 	{Error::Code::TooLong, "too long"},
 	{Error::Code::TooSmall, "too small"},
 	{Error::Code::TooLarge, "too large"},
+	{Error::Code::AmbiguousArgument, "ambiguous argument"},
+	{Error::Code::Unexpected, "unexpected error"},
 };
 
 Error::Error(Code code)
@@ -57,6 +59,13 @@ Error& Error::help(const std::string& help)
 	return *this;
 }
 
+Error& Error::location(const std::string& file, size_t line)
+{
+	context.file = file;
+	context.line = line;
+	return *this;
+}
+
 const char* Error::argument() const
 {
 	return context.argument.c_str();
@@ -72,6 +81,16 @@ const char* Error::help() const
 	return context.help.c_str();
 }
 
+const char* Error::file() const
+{
+	return context.file.c_str();
+}
+
+size_t Error::line() const
+{
+	return context.line;
+}
+
 Error::Code Error::code() const
 {
 	return context.code;
@@ -92,4 +111,9 @@ bool Error::hasHelp() const
 	return !context.help.empty();
 }
 
+bool Error::hasLocation() const
+{
+	return !context.file.empty();
+}
+
 }
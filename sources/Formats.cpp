@@ -0,0 +1,370 @@
+#include "Formats.h"
+#include "Error.h"
+
+namespace az::cli
+{
+
+namespace
+{
+
+bool isDigit(char ch)
+{
+	return ch >= '0' && ch <= '9';
+}
+
+int hexDigit(char ch)
+{
+	if (ch >= '0' && ch <= '9') {
+		return ch - '0';
+	}
+	if (ch >= 'a' && ch <= 'f') {
+		return ch - 'a' + 10;
+	}
+	if (ch >= 'A' && ch <= 'F') {
+		return ch - 'A' + 10;
+	}
+	return -1;
+}
+
+// Reads exactly @count decimal digits from @pos into @number
+bool readDigits(std::string_view source, size_t& pos, size_t count, int& number)
+{
+	if (pos + count > source.size()) {
+		return false;
+	}
+	number = 0;
+	for (size_t end = pos + count; pos != end; pos++) {
+		if (!isDigit(source[pos])) {
+			return false;
+		}
+		number = number * 10 + (source[pos] - '0');
+	}
+	return true;
+}
+
+// Reads @expected character at @pos
+bool readChar(std::string_view source, size_t& pos, char expected)
+{
+	if (pos < source.size() && source[pos] == expected) {
+		pos++;
+		return true;
+	}
+	return false;
+}
+
+bool isLeapYear(int year)
+{
+	return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int daysInMonth(int year, int month)
+{
+	static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	return month == 2 && isLeapYear(year) ? 29 : days[month - 1];
+}
+
+// Number of days since 1970-01-01 of the proleptic Gregorian calendar date
+int64_t daysSinceEpoch(int year, int month, int day)
+{
+	year -= month <= 2;
+	int64_t era = (year >= 0 ? year : year - 399) / 400;
+	int64_t year_of_era = year - era * 400;
+	int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+	int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+	return era * 146097 + day_of_era - 719468;
+}
+
+}
+
+FormatValidator::FormatValidator(const char* format)
+	: format(format)
+{
+}
+
+bool FormatValidator::check(const std::string& source) const
+{
+	if (!accepts(source)) {
+		throw Error(Error::Code::InvalidValue).value(source).help(format);
+	}
+	return Validator::check(source);
+}
+
+bool FormatValidator::isStreamable() const
+{
+	return false;
+}
+
+Ipv4Validator::Ipv4Validator()
+	: FormatValidator("a.b.c.d")
+{
+	integer("ipv4");
+}
+
+bool Ipv4Validator::parse(std::string_view source, uint32_t& address)
+{
+	address = 0;
+	size_t pos = 0;
+	for (int octet = 0; octet < 4; octet++) {
+		if (octet > 0 && !readChar(source, pos, '.')) {
+			return false;
+		}
+		size_t start = pos;
+		uint32_t number = 0;
+		while (pos < source.size() && isDigit(source[pos]) && pos - start < 3) {
+			number = number * 10 + (source[pos++] - '0');
+		}
+		// leading zeros are not allowed because they are treated as octal numbers by some tools
+		bool leading_zero = pos - start > 1 && source[start] == '0';
+		if (pos == start || leading_zero || number > 255) {
+			return false;
+		}
+		address = (address << 8) | number;
+	}
+	return pos == source.size();
+}
+
+bool Ipv4Validator::accepts(std::string_view source) const
+{
+	uint32_t address;
+	return parse(source, address);
+}
+
+Value Ipv4Validator::apply(const std::string& source) const
+{
+	uint32_t address;
+	if (!parse(source, address)) {
+		throw Error(Error::Code::InvalidValue).value(source);
+	}
+	return int64_t(address);
+}
+
+UuidValidator::UuidValidator()
+	: FormatValidator("xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx")
+{
+	string("uuid");
+}
+
+bool UuidValidator::parse(std::string_view source, char (&uuid)[37])
+{
+	if (source.size() == 38 && source.front() == '{' && source.back() == '}') {
+		source = source.substr(1, 36);
+	}
+	if (source.size() != 36) {
+		return false;
+	}
+	static const char* digits = "0123456789abcdef";
+	for (size_t pos = 0; pos < 36; pos++) {
+		if (pos == 8 || pos == 13 || pos == 18 || pos == 23) {
+			if (source[pos] != '-') {
+				return false;
+			}
+			uuid[pos] = '-';
+			continue;
+		}
+		int digit = hexDigit(source[pos]);
+		if (digit < 0) {
+			return false;
+		}
+		uuid[pos] = digits[digit];
+	}
+	uuid[36] = '\0';
+	return true;
+}
+
+bool UuidValidator::accepts(std::string_view source) const
+{
+	char uuid[37];
+	return parse(source, uuid);
+}
+
+Value UuidValidator::apply(const std::string& source) const
+{
+	char uuid[37];
+	if (!parse(source, uuid)) {
+		throw Error(Error::Code::InvalidValue).value(source);
+	}
+	return uuid;
+}
+
+Iso8601Validator::Iso8601Validator()
+	: FormatValidator("YYYY-MM-DD[Thh:mm[:ss[.s]][Z|+hh:mm]]")
+{
+	integer("date");
+}
+
+bool Iso8601Validator::parse(std::string_view source, int64_t& seconds)
+{
+	size_t pos = 0;
+	int year, month, day, hours = 0, minutes = 0, secs = 0;
+	if (!readDigits(source, pos, 4, year) || !readChar(source, pos, '-') ||
+		!readDigits(source, pos, 2, month) || !readChar(source, pos, '-') ||
+		!readDigits(source, pos, 2, day)) {
+		return false;
+	}
+	if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+		return false;
+	}
+	int64_t offset = 0;
+	if (pos < source.size()) {
+		if (!readChar(source, pos, 'T') && !readChar(source, pos, 't') && !readChar(source, pos, ' ')) {
+			return false;
+		}
+		if (!readDigits(source, pos, 2, hours) || !readChar(source, pos, ':') ||
+			!readDigits(source, pos, 2, minutes)) {
+			return false;
+		}
+		if (readChar(source, pos, ':')) {
+			if (!readDigits(source, pos, 2, secs)) {
+				return false;
+			}
+			// fraction of a second is accepted but ignored
+			if (readChar(source, pos, '.') || readChar(source, pos, ',')) {
+				size_t start = pos;
+				while (pos < source.size() && isDigit(source[pos])) {
+					pos++;
+				}
+				if (pos == start) {
+					return false;
+				}
+			}
+		}
+		// a leap second is allowed
+		if (hours > 23 || minutes > 59 || secs > 60) {
+			return false;
+		}
+		bool utc = readChar(source, pos, 'Z') || readChar(source, pos, 'z');
+		if (!utc && pos < source.size() && (source[pos] == '+' || source[pos] == '-')) {
+			int sign = source[pos++] == '-' ? -1 : 1;
+			int zone_hours, zone_minutes = 0;
+			if (!readDigits(source, pos, 2, zone_hours)) {
+				return false;
+			}
+			bool has_colon = readChar(source, pos, ':');
+			if ((has_colon || pos < source.size()) && !readDigits(source, pos, 2, zone_minutes)) {
+				return false;
+			}
+			if (zone_hours > 23 || zone_minutes > 59) {
+				return false;
+			}
+			offset = sign * (zone_hours * 3600 + zone_minutes * 60);
+		}
+	}
+	if (pos != source.size()) {
+		return false;
+	}
+	seconds = daysSinceEpoch(year, month, day) * 86400 + hours * 3600 + minutes * 60 + secs - offset;
+	return true;
+}
+
+bool Iso8601Validator::accepts(std::string_view source) const
+{
+	int64_t seconds;
+	return parse(source, seconds);
+}
+
+Value Iso8601Validator::apply(const std::string& source) const
+{
+	int64_t seconds;
+	if (!parse(source, seconds)) {
+		throw Error(Error::Code::InvalidValue).value(source);
+	}
+	return seconds;
+}
+
+HexValidator::HexValidator()
+	: FormatValidator("hexadecimal digits")
+{
+	string("hex");
+}
+
+bool HexValidator::accepts(std::string_view source) const
+{
+	for (char ch : source) {
+		if (hexDigit(ch) < 0) {
+			return false;
+		}
+	}
+	return !source.empty();
+}
+
+Value HexValidator::apply(const std::string& source) const
+{
+	if (!accepts(source)) {
+		throw Error(Error::Code::InvalidValue).value(source);
+	}
+	std::string token(source);
+	for (auto& ch : token) {
+		if (ch >= 'A' && ch <= 'F') {
+			ch += 'a' - 'A';
+		}
+	}
+	return token;
+}
+
+SizeValidator::SizeValidator()
+	: FormatValidator("number[K|M|G|T|P|E][iB|B]")
+{
+	integer("size");
+}
+
+bool SizeValidator::parse(std::string_view source, int64_t& bytes)
+{
+	const uint64_t limit = uint64_t(INT64_MAX);
+	uint64_t number = 0;
+	size_t pos = 0;
+	while (pos < source.size() && isDigit(source[pos])) {
+		uint64_t digit = source[pos++] - '0';
+		if (number > (limit - digit) / 10) {
+			return false;
+		}
+		number = number * 10 + digit;
+	}
+	if (pos == 0) {
+		return false;
+	}
+	int shift = 0;
+	if (pos < source.size()) {
+		switch (source[pos]) {
+			case 'k': case 'K': shift = 10; break;
+			case 'm': case 'M': shift = 20; break;
+			case 'g': case 'G': shift = 30; break;
+			case 't': case 'T': shift = 40; break;
+			case 'p': case 'P': shift = 50; break;
+			case 'e': case 'E': shift = 60; break;
+			default: break;
+		}
+		if (shift > 0) {
+			pos++;
+			// KiB requires B while K & KB are the same
+			bool binary = readChar(source, pos, 'i');
+			if (!readChar(source, pos, 'B') && binary) {
+				return false;
+			}
+		}
+		else {
+			readChar(source, pos, 'B');
+		}
+	}
+	if (pos != source.size() || number > (limit >> shift)) {
+		return false;
+	}
+	bytes = int64_t(number << shift);
+	return true;
+}
+
+bool SizeValidator::accepts(std::string_view source) const
+{
+	int64_t bytes;
+	return parse(source, bytes);
+}
+
+Value SizeValidator::apply(const std::string& source) const
+{
+	int64_t bytes;
+	if (!parse(source, bytes)) {
+		throw Error(Error::Code::InvalidValue).value(source);
+	}
+	return bytes;
+}
+
+}
@@ -0,0 +1,248 @@
+#include "Group.h"
+#include <numeric>
+
+namespace az::cli
+{
+
+Group::Group(const Group& other)
+	: arguments(other.arguments)
+{
+	// the index of the other group refers to its own arguments, so it's built again on demand
+}
+
+Group::Group(const std::list<Argument>& arguments)
+	: arguments(arguments)
+{
+}
+
+Group::Group(std::list<Argument>&& arguments)
+	: arguments(std::move(arguments))
+{
+}
+
+void Group::index() const
+{
+	size_t keys_count = 0;
+	for (const auto& argument : arguments) {
+		keys_count += argument.getHashedKeys().size();
+	}
+	// keep the table at most half full to make probe sequences short
+	size_t capacity = 8;
+	while (capacity < keys_count * 2) {
+		capacity *= 2;
+	}
+	slots.assign(capacity, Slot());
+
+	for (const auto& argument : arguments) {
+		// disabled arguments are never parsed, but their keys are still known (see recognize)
+		if (!argument.isEnabled()) {
+			for (const auto& key : argument.getHashedKeys()) {
+				insert(key, &argument);
+			}
+			continue;
+		}
+		for (const auto& key : argument.getHashedKeys()) {
+			if (argument.isPrefixed()) {
+				prefixes.insert(key.name, &argument);
+			}
+			if (key.name.size() == 2 && key.name[0] == '-' && key.name[1] != '-') {
+				auto& short_argument = shorts[uint8_t(key.name[1])];
+				if (!short_argument) {
+					short_argument = &argument;
+				}
+			}
+			insert(key, &argument);
+		}
+	}
+	indexed = true;
+}
+
+void Group::insert(const Argument::Key& key, const Argument* argument) const
+{
+	auto mask = slots.size() - 1;
+	for (size_t pos = key.hash & mask;; pos = (pos + 1) & mask) {
+		auto& slot = slots[pos];
+		if (!slot.argument) {
+			slot = {key.hash, key.name, argument};
+			return;
+		}
+		if (slot.hash == key.hash && slot.key == key.name) {
+			// the first enabled argument with the key wins
+			if (!slot.argument->isEnabled() && argument->isEnabled()) {
+				slot.argument = argument;
+			}
+			return;
+		}
+	}
+}
+
+const Argument* Group::lookup(const char* arg) const
+{
+	if (!indexed) {
+		index();
+	}
+	auto key = Argument::getKeyOf(arg);
+	auto hash = Argument::hash(key);
+	auto mask = slots.size() - 1;
+	for (size_t pos = hash & mask; slots[pos].argument; pos = (pos + 1) & mask) {
+		if (slots[pos].hash == hash && slots[pos].key == key) {
+			return slots[pos].argument;
+		}
+	}
+	return nullptr;
+}
+
+const Argument* Group::find(const char* arg) const
+{
+	auto argument = lookup(arg);
+	return argument && argument->isEnabled() ? argument : nullptr;
+}
+
+bool Group::recognize(const char* arg) const
+{
+	return lookup(arg) != nullptr;
+}
+
+void Group::indexCompletions() const
+{
+	for (const auto& argument : arguments) {
+		if (argument.isEnabled()) {
+			for (const auto& key : argument.getHashedKeys()) {
+				trie.insert(key.name, &argument);
+			}
+		}
+	}
+}
+
+void Group::compile() const
+{
+	if (!indexed) {
+		index();
+	}
+	if (trie.empty()) {
+		indexCompletions();
+	}
+}
+
+const Argument* Group::complete(const char* arg) const
+{
+	if (trie.empty()) {
+		indexCompletions();
+	}
+	auto prefix = Argument::getKeyOf(arg);
+	std::vector<std::string_view> candidates;
+	auto argument = trie.complete(prefix, &candidates);
+	if (!candidates.empty()) {
+		throw Error(Error::Code::AmbiguousArgument).argument(std::string(prefix))
+			.help(std::accumulate(std::next(candidates.begin()), candidates.end(), std::string(candidates.front()),
+				[](std::string all, std::string_view one) { return std::move(all) + ", " + std::string(one); }));
+	}
+	return argument;
+}
+
+const Argument* Group::findByPrefix(const char* arg, const char*& value) const
+{
+	if (!indexed) {
+		index();
+	}
+	if (prefixes.empty()) {
+		return nullptr;
+	}
+	size_t length = 0;
+	auto argument = prefixes.findLongestPrefix(arg, length);
+	if (argument) {
+		value = arg + length;
+	}
+	return argument;
+}
+
+const Argument* Group::findShort(char key) const
+{
+	if (!indexed) {
+		index();
+	}
+	return shorts[uint8_t(key)];
+}
+
+bool Group::empty() const
+{
+	return arguments.empty();
+}
+
+size_t Group::size() const
+{
+	return arguments.size();
+}
+
+std::list<Argument>::const_iterator Group::begin() const
+{
+	return arguments.begin();
+}
+
+std::list<Argument>::const_iterator Group::end() const
+{
+	return arguments.end();
+}
+
+void Argumentation::push(Group&& group)
+{
+	owned.push_back(std::move(group));
+	push(owned.back());
+}
+
+void Argumentation::push(const Group& group)
+{
+	groups.push_back(&group);
+}
+
+void Argumentation::pop()
+{
+	if (!owned.empty() && &owned.back() == groups.back()) {
+		owned.pop_back();
+	}
+	groups.pop_back();
+}
+
+void Argumentation::clear()
+{
+	groups.clear();
+	owned.clear();
+}
+
+const Group& Argumentation::back() const
+{
+	return *groups.back();
+}
+
+bool Argumentation::empty() const
+{
+	return groups.empty();
+}
+
+size_t Argumentation::size() const
+{
+	return groups.size();
+}
+
+int Argumentation::recognize(const char* arg) const
+{
+	// misses of the current group are rare, so the ancestors are asked by their own indexes on demand
+	//   instead of keeping a common index of keys up to date on every push and pop
+	int level = int(groups.size()) - 2;
+	for (auto group = ++groups.rbegin(); group != groups.rend(); group++, level--) {
+		if ((*group)->recognize(arg)) {
+			return level;
+		}
+	}
+	// keys of prefixed arguments can't be found by whole keys, so they're matched the last
+	level = int(groups.size()) - 2;
+	for (auto group = ++groups.rbegin(); group != groups.rend(); group++, level--) {
+		const char* value = nullptr;
+		if ((*group)->findByPrefix(arg, value)) {
+			return level;
+		}
+	}
+	return -1;
+}
+
+}
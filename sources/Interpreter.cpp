@@ -1,6 +1,10 @@
 #include "Interpreter.h"
 #include <sstream>
 #include <string.h>
+#include <mutex>
+#include <deque>
+#include <algorithm>
+#include <condition_variable>
 #include "Printer.h"
 
 namespace az::cli
@@ -11,18 +15,80 @@ Interpreter::Interpreter(const char** argv, int argc, const Options& options)
 {
 }
 
+Interpreter& Interpreter::reset()
+{
+	cursor.rewind();
+	cursor.expandFiles(options.expand_files);
+	cursor.allowDescriptors(options.allow_descriptors);
+	environment.clear();
+	actions.clear();
+	outcomes.clear();
+	argumentation.clear();
+	sections.clear();
+	return *this;
+}
+
+Interpreter& Interpreter::reset(std::span<const char*> args)
+{
+	cursor = Cursor(args.data(), args.size());
+	cursor.expandFiles(options.expand_files);
+	cursor.allowDescriptors(options.allow_descriptors);
+	environment.clear();
+	actions.clear();
+	outcomes.clear();
+	argumentation.clear();
+	sections.clear();
+	return *this;
+}
+
 Interpreter& Interpreter::doEverything(bool whether)
 {
 	options.do_everything = whether;
 	return *this;
 }
 
+Interpreter& Interpreter::expandFiles(bool whether)
+{
+	options.expand_files = whether;
+	return *this;
+}
+
+Interpreter& Interpreter::allowDescriptors(bool whether)
+{
+	options.allow_descriptors = whether;
+	return *this;
+}
+
+Interpreter& Interpreter::configure(const Configuration* configuration)
+{
+	this->configuration = configuration;
+	return *this;
+}
+
+Interpreter& Interpreter::inParallel(unsigned threads)
+{
+	options.parallel_actions = threads;
+	return *this;
+}
+
 Interpreter& Interpreter::ignoreUnknown(bool whether)
 {
 	options.ignore_unknown = whether;
 	return *this;
 }
 
+Interpreter& Interpreter::allowAbbreviations(bool whether)
+{
+	options.allow_abbreviations = whether;
+	return *this;
+}
+
+Interpreter& Interpreter::allowBundling(bool whether)
+{
+	options.allow_bundling = whether;
+	return *this;
+}
+
 Interpreter& Interpreter::withNeedHelpString(const char* string)
 {
 	options.need_help_string = string;
@@ -31,13 +97,22 @@ Interpreter& Interpreter::withNeedHelpString(const char* string)
 
 Interpreter& Interpreter::interactively(const Argument::Interactor& interactor)
 {
+	if (interactor.async_input) {
+		return interactively(interactor.async_input, interactor.timeout, interactor.blame);
+	}
 	return interactively(interactor.input, interactor.blame);
 }
 
+Interpreter& Interpreter::interactively(const Argument::Interactor::AsyncInput& input,
+	std::chrono::milliseconds timeout, const Argument::Interactor::Blame& blame)
+{
+	interactor = Argument::Interactor(input, timeout, blame ? blame : this->blame);
+	return *this;
+}
+
 Interpreter& Interpreter::interactively(const Argument::Interactor::Input& input, const Argument::Interactor::Blame& blame)
 {
-	interactor.input = input ? input : this->input;
-	interactor.blame = blame ? blame : this->blame;
+	interactor = Argument::Interactor(input ? input : this->input, blame ? blame : this->blame);
 	return *this;
 }
 
@@ -46,25 +121,63 @@ int Interpreter::print(const Argument& argument, const Usage& usage, std::ostrea
 	return Printer(stream).recursively().print(argument, usage);
 }
 
-bool Interpreter::parse(const Argument& argument, const Usage& usage, Context& context)
+bool Interpreter::parse(const Argument& argument, const Usage& usage, Context& context, const char* arg)
 {
-	if (!argument.parse(cursor, context)) {
+	// values of an argument with arity end where a discovered argument starts
+	Argument::Recognizer recognizer;
+	if (!argumentation.empty()) {
+		recognizer = [this](const char* arg) {
+			const char* value = nullptr;
+			return options.need_help_string == arg ||
+				argumentation.back().find(arg) || argumentation.back().findByPrefix(arg, value) || recognize(arg);
+		};
+	}
+	if (!(arg ? argument.parse(arg, cursor, context, recognizer) : argument.parse(cursor, context, recognizer))) {
 		return false;
 	}
 
 	// memorize discovered arguments for ability of recursive calls
 	// to recognize unknown ones and to skip them if needs to
-	argumentation.push_back(usage(argument));
+	if (compiled_usage) {
+		argumentation.push(compiled_usage->group(argument));
+	}
+	else if (usage_cache) {
+		argumentation.push(usage_cache->group(argument));
+	}
+	else {
+		argumentation.push(usage(argument));
+	}
+	// the app takes the top settings and subcommands take their nested sections
+	if (configuration) {
+		sections.push_back(sections.empty() ? &configuration->root()
+			: sections.back() ? sections.back()->section(argument) : nullptr);
+	}
 
 	while (!cursor.eol()) {
-		bool parsed = false;
-		for (const auto& sub_argument : argumentation.back()) {
-			parsed = parse(sub_argument, usage, context);
-			if (parsed) {
-				break;
+		// dispatch the argument straight to the one having its key
+		auto sub_argument = argumentation.back().find(cursor.arg());
+		const char* matched = nullptr;
+		if (!sub_argument) {
+			sub_argument = argumentation.back().findByPrefix(cursor.arg(), matched);
+		}
+		// an exact key of an ancestor group wins over bundles and abbreviations of keys of the current one
+		if (!sub_argument && options.allow_bundling && !recognize(cursor.arg()) && parseBundle(usage, context)) {
+			continue;
+		}
+		if (!sub_argument && options.allow_abbreviations && options.need_help_string != cursor.arg() &&
+			!recognize(cursor.arg())) {
+			try {
+				sub_argument = argumentation.back().complete(cursor.arg());
+				matched = Argument::getValueOf(cursor.arg());
+			}
+			catch (const Error&) {
+				// an ambiguous abbreviation is unknown as well, so it's skipped if unknown ones are ignored
+				if (!options.ignore_unknown) {
+					throw;
+				}
 			}
 		}
-		if (!parsed) {
+		if (!sub_argument || !parse(*sub_argument, usage, context, matched)) {
 			if (options.need_help_string == cursor.arg()) {
 				std::stringstream help; print(argument, usage, help);
 				throw Error(Error::Code::NeedHelp).help(help.str());
@@ -80,12 +193,16 @@ bool Interpreter::parse(const Argument& argument, const Usage& usage, Context& c
 		}
 	}
 	// provide @context with input or default values of sub arguments
+	auto section = configuration ? sections.back() : nullptr;
 	for (const auto& sub_argument : argumentation.back()) {
-		sub_argument.provideValue(interactor, context);
+		sub_argument.provideValue(interactor, context, &environment, section ? section->find(sub_argument) : nullptr);
+	}
+	if (configuration) {
+		sections.pop_back();
 	}
 	// current (last) argument group is not needed anymore for previous recursive call
 	// so it should be dropped; thus the @argumentation is gonna be clean in the end
-	argumentation.pop_back();
+	argumentation.pop();
 
 	if (argument.hasAction()) {
 		actions.push_back(argument);
@@ -93,34 +210,236 @@ bool Interpreter::parse(const Argument& argument, const Usage& usage, Context& c
 	return true;
 }
 
-bool Interpreter::recognize(const char* arg) const
+bool Interpreter::parseBundle(const Usage& usage, Context& context)
 {
-	// search @arg among discovered argument groups except the last one in the reverse order, because:
-	//   the last one is supposed to be already checked by the time the function is called;
-	//   the reverse order predicts that @arg is more likely presented in the recent groups.
-	for (auto from = ++argumentation.rbegin(), to = argumentation.rend(); from != to; from++) {
-		for (const auto& argument : *from) {
-			if (argument.match(arg)) {
-				return true;
-			}
+	auto bundle = cursor.arg();
+	if (bundle[0] != '-' || !bundle[1] || bundle[1] == '-' || !bundle[2]) {
+		return false;
+	}
+	const auto& group = argumentation.back();
+	// every key should be known up to the one taking the rest of the bundle as a value
+	for (auto key = bundle + 1; *key; key++) {
+		auto argument = group.findShort(*key);
+		if (!argument) {
+			return false;
+		}
+		if (argument->needValue()) {
+			break;
+		}
+	}
+	for (auto key = bundle + 1; *key; key++) {
+		const auto& argument = *group.findShort(*key);
+		if (argument.needValue() || !key[1]) {
+			// the last argument consumes the bundle with its attached value if any
+			parse(argument, usage, context, argument.needValue() && key[1] ? key + 1 : bundle);
+			break;
 		}
+		// the others are parsed as if each one is passed separately
+		auto position = cursor;
+		parse(argument, usage, context, bundle);
+		cursor = position;
 	}
-	return false;
+	return true;
+}
+
+bool Interpreter::recognize(const char* arg) const
+{
+	// search @arg among discovered argument groups except the last one, because
+	//   the last one is supposed to be already checked by the time the function is called
+	return argumentation.recognize(arg) >= 0;
 }
 
 int Interpreter::run(const Argument& app, const Usage& usage, Context& context)
 {
+	// the previous run could be interrupted by an error, so its state is dropped anyway
+	reset();
+	context.clearStates();
 	parse(app, usage, context);
 
+	if (options.do_everything && options.parallel_actions > 1 && actions.size() > 1) {
+		perform(context);
+		for (const auto& outcome : outcomes) {
+			if (outcome.error) {
+				std::rethrow_exception(outcome.error);
+			}
+		}
+		return app.id();
+	}
 	for (const auto& action : actions) {
-		int result = action.perform(context);
+		auto& outcome = outcomes.emplace_back();
+		outcome.id = action.id();
+		outcome.performed = true;
+		outcome.result = action.perform(context);
 		if (!options.do_everything) {
-			return result;
+			return outcome.result;
 		}
 	}
 	return app.id();
 }
 
+void Interpreter::perform(const Context& context)
+{
+	outcomes.assign(actions.size(), Outcome());
+	// numbers of dependencies each action waits for and actions which wait for each action
+	std::vector<size_t> waits(actions.size());
+	std::vector<std::vector<size_t>> dependents(actions.size());
+	for (size_t index = 0; index < actions.size(); index++) {
+		outcomes[index].id = actions[index].id();
+		for (int id : actions[index].getDependencies()) {
+			for (size_t other = 0; other < actions.size(); other++) {
+				if (other != index && actions[other].id() == id) {
+					dependents[other].push_back(index);
+					waits[index]++;
+				}
+			}
+		}
+	}
+	std::deque<size_t> ready;
+	for (size_t index = 0; index < actions.size(); index++) {
+		if (!waits[index]) {
+			ready.push_back(index);
+		}
+	}
+	std::mutex mutex;
+	std::condition_variable condition;
+	size_t running = 0;
+	auto work = [&] {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true) {
+			condition.wait(lock, [&] { return !ready.empty() || !running; });
+			if (ready.empty()) {
+				break; // nothing is running, so nothing is gonna be ready
+			}
+			auto index = ready.front();
+			ready.pop_front();
+			running++;
+			lock.unlock();
+
+			auto& outcome = outcomes[index];
+			outcome.performed = true;
+			try {
+				outcome.result = actions[index].perform(context);
+			}
+			catch (...) {
+				outcome.error = std::current_exception();
+			}
+
+			lock.lock();
+			running--;
+			if (!outcome.error) {
+				for (auto dependent : dependents[index]) {
+					if (!--waits[dependent]) {
+						ready.push_back(dependent);
+					}
+				}
+			}
+			condition.notify_all();
+		}
+	};
+	std::vector<std::thread> threads;
+	for (size_t count = std::min<size_t>(options.parallel_actions, actions.size()); count > 1; count--) {
+		threads.emplace_back(work);
+	}
+	work();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+int Interpreter::repl(std::istream& stream, const CompiledUsage& usage,
+	const Argument::Interactor::Blame& blame, const Latency& latency)
+{
+	auto blame_error = blame ? blame : interactor.blame ? interactor.blame : this->blame;
+	int result = usage.root().id();
+	std::string line;
+	std::string app = usage.root().getLongestKey();
+	while (std::getline(stream, line)) {
+		auto start = std::chrono::steady_clock::now();
+		try {
+			// the first argument is the name of the app as it is in argv
+			auto args = tokenizer.split(line, app.c_str());
+			if (args.size() == 1) {
+				continue;
+			}
+			Context context;
+			result = run(args, usage, context);
+		}
+		catch (const Error& error) {
+			blame_error(error);
+		}
+		catch (const std::exception& error) {
+			blame_error(Error(Error::Code::Unexpected).value(line).help(error.what()));
+		}
+		if (latency) {
+			latency(line, std::chrono::steady_clock::now() - start);
+		}
+	}
+	return result;
+}
+
+int Interpreter::repl(std::istream& stream, const Argument& app, const Usage& usage,
+	const Argument::Interactor::Blame& blame, const Latency& latency)
+{
+	return repl(stream, CompiledUsage(app, usage), blame, latency);
+}
+
+const std::vector<Interpreter::Outcome>& Interpreter::getOutcomes() const
+{
+	return outcomes;
+}
+
+int Interpreter::run(const CompiledUsage& usage, Context& context)
+{
+	compiled_usage = &usage;
+	try {
+		int result = run(usage.root(), usage.usage(), context);
+		compiled_usage = nullptr;
+		return result;
+	}
+	catch (...) {
+		compiled_usage = nullptr;
+		throw;
+	}
+}
+
+int Interpreter::run(const Argument& app, const UsageCache& usage, Context& context)
+{
+	usage_cache = &usage;
+	try {
+		int result = run(app, usage.usage(), context);
+		usage_cache = nullptr;
+		return result;
+	}
+	catch (...) {
+		usage_cache = nullptr;
+		throw;
+	}
+}
+
+int Interpreter::run(const Argument& app, const UsageCache& usage)
+{
+	Context context;
+	return run(app, usage, context);
+}
+
+int Interpreter::run(std::span<const char*> args, const Argument& app, const Usage& usage, Context& context)
+{
+	reset(args);
+	return run(app, usage, context);
+}
+
+int Interpreter::run(std::span<const char*> args, const CompiledUsage& usage, Context& context)
+{
+	reset(args);
+	return run(usage, context);
+}
+
+int Interpreter::run(const CompiledUsage& usage)
+{
+	Context context;
+	return run(usage, context);
+}
+
 int Interpreter::run(const Argument& app, const Usage& usage)
 {
 	Context context;
@@ -140,6 +459,10 @@ std::string Interpreter::input(const Argument& argument)
 
 void Interpreter::blame(const Error& error)
 {
+	if (error.code() == Error::Code::NeedHelp) {
+		printf("%s\n", error.help());
+		return;
+	}
 	printf("Error: %s. Try again!\n", error.what());
 }
 
@@ -0,0 +1,91 @@
+#include "MappedFile.h"
+#include "Error.h"
+#include <fstream>
+#if !defined(_WIN32)
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace az::cli
+{
+
+MappedFile::MappedFile(const std::string& path)
+	: file_path(path)
+{
+	bool readable = false;
+#if !defined(_WIN32)
+	int descriptor = open(path.c_str(), O_RDONLY);
+	struct stat status;
+	if (descriptor >= 0 && fstat(descriptor, &status) == 0) {
+		if (S_ISREG(status.st_mode)) {
+			file_size = status.st_size;
+			void* mapping = file_size ? mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, descriptor, 0) : nullptr;
+			if (mapping != MAP_FAILED) {
+				file_data = static_cast<char*>(mapping);
+				mapped = file_size > 0;
+				readable = true;
+			}
+		}
+		else {
+			// pipes and special files have no size to map, so they're read till the end
+			char chunk[64 * 1024];
+			ssize_t size;
+			while ((size = read(descriptor, chunk, sizeof(chunk))) != 0) {
+				if (size < 0 && errno == EINTR) {
+					continue;
+				}
+				if (size < 0) {
+					break;
+				}
+				content.append(chunk, size);
+			}
+			file_data = content.data();
+			file_size = content.size();
+			readable = size == 0;
+		}
+	}
+	if (descriptor >= 0) {
+		close(descriptor);
+	}
+#else
+	std::ifstream stream(path, std::ios::binary);
+	if (stream) {
+		content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		file_data = content.data();
+		file_size = content.size();
+		readable = true;
+	}
+#endif
+	if (!readable) {
+		throw Error(Error::Code::InvalidArgument).argument(path).help("can't read the file");
+	}
+}
+
+MappedFile::~MappedFile()
+{
+#if !defined(_WIN32)
+	if (mapped) {
+		munmap(file_data, file_size);
+	}
+#endif
+}
+
+char* MappedFile::data() const
+{
+	return file_data;
+}
+
+size_t MappedFile::size() const
+{
+	return file_size;
+}
+
+const std::string& MappedFile::path() const
+{
+	return file_path;
+}
+
+}
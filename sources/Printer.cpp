@@ -56,6 +56,11 @@ int Printer::print(const Argument& argument, const Usage& usage, int margin) con
 	return argument.id();
 }
 
+int Printer::print(const Argument& argument, const UsageCache& usage, int margin) const
+{
+	return print(argument, usage.usage(), margin);
+}
+
 void Printer::print(const Argument& argument, int margin) const
 {
 	auto offset = [](int spaces){ return std::string(spaces, ' '); };
@@ -0,0 +1,129 @@
+#include "Tokenizer.h"
+#include "Error.h"
+#include <bit>
+#include <algorithm>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace az::cli
+{
+
+namespace
+{
+
+const std::string_view spaces = " \t\r\n";
+// characters which break a run of ordinary characters in an argument
+const std::string_view unquoted_specials = " \t\r\n'\"\\";
+const std::string_view single_quoted_specials = "'";
+const std::string_view double_quoted_specials = "\"\\";
+
+bool isSpace(char character)
+{
+	return spaces.find(character) != std::string_view::npos;
+}
+
+}
+
+size_t Tokenizer::find(std::string_view line, size_t pos, std::string_view chars)
+{
+#if defined(__SSE2__)
+	// compare 16 characters with each of @chars at once
+	__m128i patterns[8];
+	size_t count = std::min<size_t>(chars.size(), 8);
+	for (size_t index = 0; index < count; index++) {
+		patterns[index] = _mm_set1_epi8(chars[index]);
+	}
+	if (count == chars.size()) {
+		for (; pos + 16 <= line.size(); pos += 16) {
+			auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line.data() + pos));
+			auto matches = _mm_cmpeq_epi8(block, patterns[0]);
+			for (size_t index = 1; index < count; index++) {
+				matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, patterns[index]));
+			}
+			if (auto mask = unsigned(_mm_movemask_epi8(matches))) {
+				return pos + std::countr_zero(mask);
+			}
+		}
+	}
+#endif
+	for (; pos < line.size(); pos++) {
+		if (chars.find(line[pos]) != std::string_view::npos) {
+			return pos;
+		}
+	}
+	return line.size();
+}
+
+std::span<const char*> Tokenizer::split(std::string_view line, const char* first)
+{
+	buffer.clear();
+	offsets.clear();
+	size_t pos = 0;
+	while (true) {
+		while (pos < line.size() && isSpace(line[pos])) {
+			pos++;
+		}
+		if (pos == line.size()) {
+			break;
+		}
+		offsets.push_back(buffer.size());
+		while (pos < line.size() && !isSpace(line[pos])) {
+			// copy ordinary characters at once
+			size_t next = find(line, pos, unquoted_specials);
+			buffer.append(line, pos, next - pos);
+			pos = next;
+			if (pos == line.size() || isSpace(line[pos])) {
+				break;
+			}
+			char quote = line[pos++];
+			if (quote == '\\') {
+				buffer.push_back(pos < line.size() ? line[pos++] : quote);
+				continue;
+			}
+			const auto& specials = quote == '"' ? double_quoted_specials : single_quoted_specials;
+			while (true) {
+				next = find(line, pos, specials);
+				buffer.append(line, pos, next - pos);
+				pos = next;
+				if (pos == line.size()) {
+					throw Error(Error::Code::InvalidEnd).value(std::string(line)).help(std::string("closing ") + quote);
+				}
+				if (line[pos] == quote) {
+					pos++;
+					break;
+				}
+				// a backslash escapes only a quote or itself in double quotes
+				if (pos + 1 < line.size() && (line[pos + 1] == '"' || line[pos + 1] == '\\')) {
+					pos++;
+				}
+				buffer.push_back(line[pos++]);
+			}
+		}
+		buffer.push_back(0);
+	}
+	// the buffer is filled completely, so pointers to it are stable now
+	views.clear();
+	args.clear();
+	if (first) {
+		args.push_back(first);
+	}
+	for (size_t index = 0; index < offsets.size(); index++) {
+		size_t end = index + 1 < offsets.size() ? offsets[index + 1] : buffer.size();
+		views.emplace_back(buffer.data() + offsets[index], end - offsets[index] - 1);
+		args.push_back(buffer.data() + offsets[index]);
+	}
+	return args;
+}
+
+std::span<const std::string_view> Tokenizer::tokens() const
+{
+	return views;
+}
+
+Cursor Tokenizer::cursor()
+{
+	return Cursor(args.data(), args.size());
+}
+
+}
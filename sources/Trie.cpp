@@ -0,0 +1,118 @@
+#include "Trie.h"
+
+namespace az::cli
+{
+
+uint32_t Trie::child(uint32_t node, char label) const
+{
+	for (uint32_t next = nodes[node].child; next; next = nodes[next].sibling) {
+		if (nodes[next].label == label) {
+			return next;
+		}
+		if (nodes[next].label > label) {
+			break; // siblings are sorted by labels
+		}
+	}
+	return 0;
+}
+
+uint32_t Trie::walk(std::string_view prefix) const
+{
+	uint32_t node = 0;
+	for (char label : prefix) {
+		node = child(node, label);
+		if (!node) {
+			break;
+		}
+	}
+	return node;
+}
+
+void Trie::insert(std::string_view key, const Argument* argument)
+{
+	uint32_t existing = walk(key);
+	if (key.empty() || (existing && nodes[existing].argument)) {
+		return;
+	}
+	uint32_t node = 0;
+	for (char label : key) {
+		auto& current = nodes[node];
+		if (!current.several && current.sole != argument) {
+			current.several = current.sole != nullptr;
+			current.sole = current.several ? nullptr : argument;
+		}
+		uint32_t next = child(node, label);
+		if (!next) {
+			// insert a new node keeping siblings sorted by labels
+			next = nodes.size();
+			Node fresh;
+			fresh.label = label;
+			uint32_t* link = &nodes[node].child;
+			while (*link && nodes[*link].label < label) {
+				link = &nodes[*link].sibling;
+			}
+			fresh.sibling = *link;
+			*link = next;
+			nodes.push_back(fresh);
+		}
+		node = next;
+	}
+	auto& last = nodes[node];
+	if (!last.several && last.sole != argument) {
+		last.several = last.sole != nullptr;
+		last.sole = last.several ? nullptr : argument;
+	}
+	last.argument = argument;
+	last.key = key;
+}
+
+const Argument* Trie::find(std::string_view key) const
+{
+	return key.empty() ? nullptr : nodes[walk(key)].argument;
+}
+
+const Argument* Trie::complete(std::string_view prefix, std::vector<std::string_view>* candidates) const
+{
+	uint32_t node = walk(prefix);
+	if (!node) {
+		return nullptr;
+	}
+	if (nodes[node].several && candidates) {
+		collect(node, *candidates);
+	}
+	return nodes[node].sole;
+}
+
+const Argument* Trie::findLongestPrefix(std::string_view string, size_t& length) const
+{
+	const Argument* argument = nullptr;
+	uint32_t node = 0;
+	for (size_t pos = 0; pos < string.size(); pos++) {
+		node = child(node, string[pos]);
+		if (!node) {
+			break;
+		}
+		if (nodes[node].argument) {
+			argument = nodes[node].argument;
+			length = pos + 1;
+		}
+	}
+	return argument;
+}
+
+void Trie::collect(uint32_t node, std::vector<std::string_view>& keys) const
+{
+	if (nodes[node].argument) {
+		keys.push_back(nodes[node].key);
+	}
+	for (uint32_t next = nodes[node].child; next; next = nodes[next].sibling) {
+		collect(next, keys);
+	}
+}
+
+bool Trie::empty() const
+{
+	return nodes.size() == 1;
+}
+
+}
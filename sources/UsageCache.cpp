@@ -0,0 +1,50 @@
+#include "UsageCache.h"
+
+namespace az::cli
+{
+
+UsageCache::UsageCache(const Usage& usage)
+	: describe(usage)
+{
+}
+
+const Group& UsageCache::group(const Argument& argument) const
+{
+	{
+		std::lock_guard lock(mutex);
+		auto found = groups.find(argument.id());
+		if (found != groups.end()) {
+			return found->second;
+		}
+	}
+	// @Usage is called without the lock, so it can be slow or consult the cache itself,
+	//   and the group is indexed before it's shared (indexes of a moved group stay valid)
+	Group group(describe(argument));
+	group.compile();
+	std::lock_guard lock(mutex);
+	// references to elements of the map stay valid while it grows; the group of a thread which is
+	//   the first to describe the argument wins, so the returned group is the same for everyone
+	return groups.emplace(argument.id(), std::move(group)).first->second;
+}
+
+Usage UsageCache::usage() const
+{
+	return [this](const Argument& argument) {
+		const auto& arguments = group(argument);
+		return std::list<Argument>(arguments.begin(), arguments.end());
+	};
+}
+
+void UsageCache::invalidate(int id)
+{
+	std::lock_guard lock(mutex);
+	groups.erase(id);
+}
+
+void UsageCache::invalidate()
+{
+	std::lock_guard lock(mutex);
+	groups.clear();
+}
+
+}
@@ -2,17 +2,67 @@
 #include <numeric>
 #include <cwctype>
 #include <regex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <mutex>
 #include "Error.h"
 
 namespace az::cli
 {
 
+// Least recently used results of validation
+// It's shared by threads validating values with the same validator, so it should be locked by @mutex
+struct Validator::Cache
+{
+	struct Result {
+		Value value;
+		std::optional<Error> error;
+	};
+	using Entry = std::pair<std::string, Result>;
+
+	explicit Cache(size_t capacity)
+		: capacity(capacity) {}
+
+	const Result* find(std::string_view raw) {
+		auto found = index.find(raw);
+		if (found == index.end()) {
+			return nullptr;
+		}
+		// move the entry to the front as the most recently used one
+		entries.splice(entries.begin(), entries, found->second);
+		return &found->second->second;
+	}
+
+	void store(std::string_view raw, Result&& result) {
+		// another thread could store the same string meanwhile
+		if (index.count(raw)) {
+			return;
+		}
+		if (entries.size() >= capacity) {
+			index.erase(entries.back().first);
+			entries.pop_back();
+		}
+		entries.emplace_front(std::string(raw), std::move(result));
+		// the index refers to the strings of list entries which are never moved
+		index.emplace(entries.front().first, entries.begin());
+	}
+
+	std::mutex mutex;
+	size_t capacity;
+	std::list<Entry> entries;
+	std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+};
+
 Validator& Validator::operator+=(const Validator& other)
 {
 	for (const auto& rule : other.rules) {
 		rules[rule.first] = rule.second;
 	}
-	return *this;
+	if (other.has(Rule::CACHE)) {
+		return cached(uint64_t(get(Rule::CACHE)));
+	}
+	return changed();
 }
 
 Validator& Validator::unit(const std::string& unit)
@@ -20,7 +70,7 @@ Validator& Validator::unit(const std::string& unit)
 	if (!unit.empty()) {
 		rules[Rule::UNIT] = unit;
 	}
-	return *this;
+	return changed();
 }
 
 Validator& Validator::boolean(const std::string& unit)
@@ -55,7 +105,7 @@ Validator& Validator::string(const std::string& unit)
 Validator& Validator::nonempty()
 {
 	rules[Rule::NONEMPTY] = true;
-	return *this;
+	return changed();
 }
 
 Validator& Validator::one_of(const std::list<Value>& variants)
@@ -64,7 +114,7 @@ Validator& Validator::one_of(const std::list<Value>& variants)
 	for (const auto& variant : variants) {
 		rules[Rule::GLOSSARY].append({variant, Value()});
 	}
-	return *this;
+	return changed();
 }
 
 Validator& Validator::glossary(const std::list<std::pair<std::string,Value>>& glossary)
@@ -73,87 +123,104 @@ Validator& Validator::glossary(const std::list<std::pair<std::string,Value>>& gl
 	for (const auto& term : glossary) {
 		rules[Rule::GLOSSARY].append({term.first, term.second});
 	}
-	return *this;
+	return changed();
 }
 
 Validator& Validator::pattern(const std::string& pattern)
 {
 	rules[Rule::PATTERN] = pattern;
-	return *this;
+	return changed();
 }
 
 Validator& Validator::no_duplicates_of(const std::string& symbols)
 {
 	rules[Rule::NO_DUPLICATES_OF] = symbols;
-	return *this;
+	return changed();
 }
 
 Validator& Validator::min(int64_t min)
 {
 	rules[Rule::MIN] = min;
-	return *this;
+	return changed();
 }
 
 Validator& Validator::max(int64_t max)
 {
 	rules[Rule::MAX] = max;
-	return *this;
+	return changed();
 }
 
 Validator& Validator::no_repeats_of(const std::string& chars)
 {
 	rules[Rule::NO_REPEATS_OF] = chars;
-	return *this;
+	return changed();
 }
 
 Validator& Validator::cannot_start_with(const std::string& chars)
 {
 	rules[Rule::CANNOT_START_WITH] = chars;
-	return *this;
+	return changed();
 }
 
 Validator& Validator::cannot_end_with(const std::string& chars)
 {
 	rules[Rule::CANNOT_END_WITH] = chars;
-	return *this;
+	return changed();
 }
 
 Validator& Validator::cannot_start_end_with(const std::string& chars)
 {
 	cannot_start_with(chars);
 	cannot_end_with(chars);
-	return *this;
+	return changed();
 }
 
 Validator& Validator::trim(const std::string& chars)
 {
 	rules[Rule::TRIM] = chars;
-	return *this;
+	return changed();
 }
 
 Validator& Validator::prefix(const std::string& prefix)
 {
 	rules[Rule::PREFIX] = prefix;
-	return *this;
+	return changed();
 }
 
 Validator& Validator::suffix(const std::string& suffix)
 {
 	rules[Rule::SUFFIX] = suffix;
-	return *this;
+	return changed();
 }
 
 Validator& Validator::lower_case()
 {
 	rules[Rule::LOWER_CASE] = true;
 	rules.erase(Rule::UPPER_CASE);
-	return *this;
+	return changed();
 }
 
 Validator& Validator::upper_case()
 {
 	rules[Rule::UPPER_CASE] = true;
 	rules.erase(Rule::LOWER_CASE);
+	return changed();
+}
+
+Validator& Validator::cached(size_t capacity)
+{
+	rules[Rule::CACHE] = int64_t(capacity);
+	// the cache is made at once, so validate() doesn't change the validator
+	cache = capacity ? std::make_shared<Cache>(capacity) : nullptr;
+	return *this;
+}
+
+Validator& Validator::changed()
+{
+	// results of the former rules are dropped, and copies of the validator keep their own cache
+	if (cache) {
+		cache = std::make_shared<Cache>(cache->capacity);
+	}
 	return *this;
 }
 
@@ -259,37 +326,37 @@ std::string Validator::amend(const char* raw) const
 
 bool Validator::check(const std::string& src) const
 {
-	if (src.empty() && get(Rule::NONEMPTY)) {
-		throw Error(Error::Code::EmptyValue);
+	try {
+		// characters and length rules are checked in one pass without a wide copy of the string
+		Stream(*this, false).feed(src).finish();
+	}
+	catch (Error& error) {
+		error.value(src);
+		throw;
 	}
-	auto wsrc = Value(src).asWideString();
 	auto type = get(Rule::TYPE);
 
 	for (const auto& suit : rules) {
 		switch (suit.first) {
 			case Rule::MIN:
 				if (type.isNumber()) {
-					if (Value(src).convert(type) < suit.second) {
+					if (apply(src).convert(type) < suit.second) {
 						throw Error(Error::Code::TooSmall).value(src).help(suit.second);
 					}
-				} else if (wsrc.length() < uint64_t(suit.second)) {
-					throw Error(Error::Code::TooShort).value(src).help(suit.second);
 				}
 				break;
 			case Rule::MAX:
 				if (type.isNumber()) {
-					if (Value(src).convert(type) > suit.second) {
+					if (apply(src).convert(type) > suit.second) {
 						throw Error(Error::Code::TooLarge).value(src).help(suit.second);
 					}
-				} else if (wsrc.length() > uint64_t(suit.second)) {
-					throw Error(Error::Code::TooLong).value(src).help(suit.second);
 				}
 				break;
 			case Rule::PATTERN:
 				try {
 					if (suit.second.isString()) {
 						std::wregex pattern(suit.second.asWideString());
-						if (!std::regex_match(wsrc, pattern)) {
+						if (!std::regex_match(Value(src).asWideString(), pattern)) {
 							throw Error(Error::Code::InvalidValue).value(src).help(suit.second);
 						}
 					}
@@ -297,32 +364,6 @@ bool Validator::check(const std::string& src) const
 					throw Error(Error::Code::InvalidRule).value(suit.second);
 				}
 				break;
-			case Rule::NO_DUPLICATES_OF:
-				for (const auto& symbol : suit.second.asWideString()) {
-					if (std::count(wsrc.begin(), wsrc.end(), symbol) > 1) {
-						throw Error(Error::Code::DuplicateChar).value(src).help(Value(symbol));
-					}
-				}
-				break;
-			case Rule::NO_REPEATS_OF: {
-				auto suspects = suit.second.asWideString();
-				for (auto prev = wsrc.begin(), curr = std::next(prev); curr != wsrc.end(); prev++, curr++) {
-					if (*prev == *curr && suspects.find(*curr) != suspects.npos) {
-						throw Error(Error::Code::RepetitiveChar).value(src).help(Value(*curr));
-					}
-				}
-				break;
-			}
-			case Rule::CANNOT_START_WITH:
-				if (suit.second.asWideString().find(wsrc.front()) != wsrc.npos) {
-					throw Error(Error::Code::InvalidStart).value(src).help(Value(wsrc.front()));
-				}
-				break;
-			case Rule::CANNOT_END_WITH:
-				if (suit.second.asWideString().find(wsrc.back()) != wsrc.npos) {
-					throw Error(Error::Code::InvalidEnd).value(src).help(Value(wsrc.back()));
-				}
-				break;
 			case Rule::GLOSSARY:
 				if (suit.second.isArray()) {
 					const auto& glossary = suit.second;
@@ -371,6 +412,177 @@ Value Validator::apply(const std::string& src) const
 	return value;
 }
 
+Validator::Stream Validator::stream() const
+{
+	return Stream(*this, true);
+}
+
+bool Validator::isStreamable() const
+{
+	return !has(Rule::PATTERN) && !has(Rule::GLOSSARY) && !get(Rule::TYPE).isNumber();
+}
+
+Validator::Stream::Stream(const Validator& validator, bool whole)
+	: validator(validator)
+{
+	// @whole means the stream is responsible for all rules, not only for characters ones
+	buffering = whole && !validator.isStreamable();
+	if (buffering) {
+		return;
+	}
+	if (validator.has(Rule::NO_DUPLICATES_OF)) {
+		no_duplicates_of = validator.get(Rule::NO_DUPLICATES_OF).asWideString();
+		duplicates.resize(no_duplicates_of.size());
+	}
+	if (validator.has(Rule::NO_REPEATS_OF)) {
+		no_repeats_of = validator.get(Rule::NO_REPEATS_OF).asWideString();
+	}
+	if (validator.has(Rule::CANNOT_START_WITH)) {
+		cannot_start_with = validator.get(Rule::CANNOT_START_WITH).asWideString();
+	}
+	if (validator.has(Rule::CANNOT_END_WITH)) {
+		cannot_end_with = validator.get(Rule::CANNOT_END_WITH).asWideString();
+	}
+	// limits of a number are checked by the value, not by the length
+	if (!validator.get(Rule::TYPE).isNumber()) {
+		if (validator.has(Rule::MIN)) {
+			min_length = uint64_t(validator.get(Rule::MIN));
+		}
+		if (validator.has(Rule::MAX)) {
+			max_length = uint64_t(validator.get(Rule::MAX));
+		}
+	}
+}
+
+Validator::Stream& Validator::Stream::feed(const std::string& chunk)
+{
+	return feed(chunk.data(), chunk.size());
+}
+
+Validator::Stream& Validator::Stream::feed(const char* data, size_t size)
+{
+	if (buffering) {
+		buffer.append(data, size);
+		return *this;
+	}
+	// decode UTF-8 octets keeping an incomplete character till the next chunk
+	for (auto octet = reinterpret_cast<const unsigned char*>(data), end = octet + size; octet != end; octet++) {
+		if (partial_octets > 0) {
+			if (*octet < 0x80 || *octet > 0xbf) {
+				throw Error(Error::Code::InvalidValue).help("invalid UTF-8 sequence");
+			}
+			partial_character = (partial_character << 6) | (*octet & 0x3f);
+			if (--partial_octets == 0) {
+				feed(partial_character);
+			}
+		}
+		else if (*octet < 0x80) {
+			feed(wchar_t(*octet));
+		}
+		else if (*octet >= 0xc0 && *octet <= 0xfd) {
+			// the number of leading 1 bits is the number of octets in the character
+			partial_octets = *octet < 0xe0 ? 1 : *octet < 0xf0 ? 2 : *octet < 0xf8 ? 3 : *octet < 0xfc ? 4 : 5;
+			partial_character = *octet & (0x3f >> partial_octets);
+		}
+		else {
+			throw Error(Error::Code::InvalidValue).help("invalid UTF-8 sequence");
+		}
+	}
+	return *this;
+}
+
+void Validator::Stream::feed(wchar_t character)
+{
+	if (characters == 0 && cannot_start_with.find(character) != cannot_start_with.npos) {
+		throw Error(Error::Code::InvalidStart).help(Value(character));
+	}
+	if (characters > 0 && character == last_character && no_repeats_of.find(character) != no_repeats_of.npos) {
+		throw Error(Error::Code::RepetitiveChar).help(Value(character));
+	}
+	auto duplicate = no_duplicates_of.find(character);
+	if (duplicate != no_duplicates_of.npos) {
+		if (duplicates[duplicate]) {
+			throw Error(Error::Code::DuplicateChar).help(Value(character));
+		}
+		duplicates[duplicate] = true;
+	}
+	if (max_length && characters == *max_length) {
+		throw Error(Error::Code::TooLong).help(std::to_string(*max_length));
+	}
+	characters++;
+	last_character = character;
+}
+
+bool Validator::Stream::finish()
+{
+	if (buffering) {
+		return validator.check(buffer);
+	}
+	if (partial_octets > 0) {
+		throw Error(Error::Code::InvalidValue).help("incomplete UTF-8 sequence");
+	}
+	if (characters == 0 && validator.get(Rule::NONEMPTY)) {
+		throw Error(Error::Code::EmptyValue);
+	}
+	if (min_length && characters < *min_length) {
+		throw Error(Error::Code::TooShort).help(std::to_string(*min_length));
+	}
+	if (characters > 0 && cannot_end_with.find(last_character) != cannot_end_with.npos) {
+		throw Error(Error::Code::InvalidEnd).help(Value(last_character));
+	}
+	return true;
+}
+
+uint64_t Validator::Stream::length() const
+{
+	return buffering ? Value(buffer).asWideString().length() : characters;
+}
+
+bool Validator::isCacheable() const
+{
+	return int64_t(get(Rule::CACHE)) > 0;
+}
+
+Value Validator::validate(const char* raw) const
+{
+	auto perform = [this](const char* raw) {
+		auto source = amend(raw);
+		if (!check(source)) {
+			throw Error(Error::Code::InvalidValue).value(source);
+		}
+		return apply(source);
+	};
+	if (!cache || !isCacheable()) {
+		return perform(raw);
+	}
+	Cache::Result result;
+	bool found = false;
+	{
+		// the result is copied because it can be evicted by another thread as soon as the cache is unlocked
+		std::lock_guard<std::mutex> lock(cache->mutex);
+		if (auto cached_result = cache->find(raw)) {
+			result = *cached_result;
+			found = true;
+		}
+	}
+	if (!found) {
+		// validation is performed unlocked, so threads don't wait each other
+		// only errors of validation are memoized, other exceptions propagate as they do without the cache
+		try {
+			result.value = perform(raw);
+		}
+		catch (const Error& error) {
+			result.error = error;
+		}
+		std::lock_guard<std::mutex> lock(cache->mutex);
+		cache->store(raw, Cache::Result(result));
+	}
+	if (result.error) {
+		throw Error(*result.error);
+	}
+	return result.value;
+}
+
 bool Validator::match(const std::string& string, const Value& value)
 {
 	try {
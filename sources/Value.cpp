@@ -92,6 +92,12 @@ Value::Value(const char* byte_string)
 	any.string_->assign(byte_string);
 }
 
+Value::Value(std::string_view byte_string)
+{
+	reset(Type::String);
+	any.string_->assign(byte_string);
+}
+
 Value::Value(const wchar_t* wide_string)
 	: Value(Convert<Utf8>().to_bytes(wide_string))
 {
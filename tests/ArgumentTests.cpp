@@ -34,4 +34,30 @@ BOOST_AUTO_TEST_CASE(make_with_default_value)
 	BOOST_CHECK_EQUAL(arg.getDefaultValue().asString(), "foo");
 }
 
+BOOST_AUTO_TEST_CASE(match_keys)
+{
+	az::cli::Argument arg(1, {"-n", "--name"}, "Description");
+	const char* assignment = "--name=value";
+	BOOST_CHECK_EQUAL(arg.match("-n"), "-n");
+	BOOST_CHECK_EQUAL(arg.match(assignment), assignment + 7);
+	BOOST_CHECK(arg.match("--nam") == nullptr);
+	BOOST_CHECK(arg.match("--names") == nullptr);
+	BOOST_CHECK(arg.match("-m") == nullptr);
+	BOOST_CHECK(arg.match("=-n") == nullptr);
+	BOOST_CHECK(arg.hasKey("--name", az::cli::Argument::hash("--name")));
+	BOOST_CHECK(!arg.hasKey("--name", az::cli::Argument::hash("-n")));
+}
+
+BOOST_AUTO_TEST_CASE(toggle_flags)
+{
+	auto arg = az::cli::Argument(1, {"-n"}, "Description").required().multiple().hidden();
+	BOOST_CHECK(arg.isRequired() && arg.isMultiple() && arg.isHidden());
+	arg.required(false).hidden(false);
+	BOOST_CHECK(!arg.isRequired() && arg.isMultiple() && !arg.isHidden());
+	auto copy = arg;
+	BOOST_CHECK_EQUAL(copy.id(), 1);
+	BOOST_CHECK_EQUAL(copy.getKeysString(), "-n");
+	BOOST_CHECK(copy.isMultiple());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -9,6 +9,7 @@ BOOST_AUTO_TEST_CASE(make_empty_error)
 	BOOST_CHECK(!error.hasArgument());
 	BOOST_CHECK(!error.hasValue());
 	BOOST_CHECK(!error.hasHelp());
+	BOOST_CHECK(!error.hasLocation());
 	BOOST_CHECK_EQUAL(error.what(), "no error");
 	BOOST_CHECK_EQUAL(error.argument(), "");
 	BOOST_CHECK_EQUAL(error.value(), "");
@@ -28,4 +29,12 @@ BOOST_AUTO_TEST_CASE(make_solid_error)
 	BOOST_CHECK_EQUAL(error.help(), "help");
 }
 
+BOOST_AUTO_TEST_CASE(locate_error)
+{
+	auto error = az::cli::Error(az::cli::Error::Code::InvalidValue).value("value").location("app.ini", 3);
+	BOOST_CHECK(error.hasLocation());
+	BOOST_CHECK_EQUAL(error.file(), "app.ini");
+	BOOST_CHECK_EQUAL(error.line(), 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,70 @@
+#include "tests.hpp"
+
+BOOST_AUTO_TEST_SUITE(FormatsTests)
+
+BOOST_AUTO_TEST_CASE(check_ipv4)
+{
+	az::cli::Ipv4Validator validator;
+	BOOST_CHECK_EQUAL(int64_t(validator.validate("192.168.0.1")), 0xc0a80001);
+	BOOST_CHECK_EQUAL(int64_t(validator.validate("0.0.0.0")), 0);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("256.0.0.1"), az::cli::Error::Code::InvalidValue);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("1.2.3"), az::cli::Error::Code::InvalidValue);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("1.2.3.04"), az::cli::Error::Code::InvalidValue);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("1.2.3.4."), az::cli::Error::Code::InvalidValue);
+}
+
+BOOST_AUTO_TEST_CASE(check_uuid)
+{
+	az::cli::UuidValidator validator;
+	BOOST_CHECK_EQUAL(validator.validate("{123E4567-E89B-12D3-A456-426614174000}").asString(),
+		"123e4567-e89b-12d3-a456-426614174000");
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("123e4567e89b12d3a456426614174000"), az::cli::Error::Code::InvalidValue);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("123e4567-e89b-12d3-a456-42661417400g"), az::cli::Error::Code::InvalidValue);
+}
+
+BOOST_AUTO_TEST_CASE(check_iso8601)
+{
+	az::cli::Iso8601Validator validator;
+	BOOST_CHECK_EQUAL(int64_t(validator.validate("1970-01-02")), 86400);
+	BOOST_CHECK_EQUAL(int64_t(validator.validate("2000-02-29T01:02:03.5Z")), 951786123);
+	BOOST_CHECK_EQUAL(int64_t(validator.validate("2000-02-29T04:02:03+03:00")), 951786123);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("2001-02-29"), az::cli::Error::Code::InvalidValue);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("2001-01-01T24:00"), az::cli::Error::Code::InvalidValue);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("2001-1-1"), az::cli::Error::Code::InvalidValue);
+}
+
+BOOST_AUTO_TEST_CASE(check_hex)
+{
+	az::cli::HexValidator validator;
+	validator.min(4).max(8);
+	BOOST_CHECK_EQUAL(validator.validate("DeadBeef").asString(), "deadbeef");
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("xyz0"), az::cli::Error::Code::InvalidValue);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("abc"), az::cli::Error::Code::TooShort);
+}
+
+BOOST_AUTO_TEST_CASE(check_size)
+{
+	az::cli::SizeValidator validator;
+	validator.max(int64_t(1) << 40);
+	BOOST_CHECK_EQUAL(int64_t(validator.validate("512")), 512);
+	BOOST_CHECK_EQUAL(int64_t(validator.validate("4k")), 4096);
+	BOOST_CHECK_EQUAL(int64_t(validator.validate("16MiB")), 16 << 20);
+	BOOST_CHECK_EQUAL(int64_t(validator.validate("2GB")), int64_t(2) << 30);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("2Ki"), az::cli::Error::Code::InvalidValue);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("K"), az::cli::Error::Code::InvalidValue);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("2P"), az::cli::Error::Code::TooLarge);
+}
+
+BOOST_AUTO_TEST_CASE(combine_with_rules)
+{
+	auto arg = az::cli::Argument(1, {"-i", "--ip"}, "Address").with_value<az::cli::Ipv4Validator>(az::cli::evaluate().trim());
+	BOOST_CHECK_EQUAL(arg.getValidation(), " <ipv4>");
+	std::vector<const char*> argv = {"app", "--ip", " 10.0.0.1 "};
+	az::cli::Cursor cursor(argv.data(), argv.size());
+	az::cli::Context context;
+	++cursor;
+	BOOST_REQUIRE(arg.parse(cursor, context));
+	BOOST_CHECK_EQUAL(int64_t(context[1]), 0x0a000001);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,76 @@
+#include "tests.hpp"
+
+BOOST_AUTO_TEST_SUITE(GroupTests)
+
+BOOST_AUTO_TEST_CASE(find_by_key)
+{
+	az::cli::Group group(test::usage(az::cli::Arg(test::Arg::CALL, {"call"}, "Call")));
+	BOOST_REQUIRE(group.find("--int"));
+	BOOST_CHECK_EQUAL(group.find("--int")->id(), test::Arg::INTEGER);
+	BOOST_CHECK_EQUAL(group.find("-r=1")->id(), test::Arg::REAL);
+	BOOST_CHECK(group.find("--in") == nullptr);
+	BOOST_CHECK(group.find("") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(find_first_of_duplicates)
+{
+	az::cli::Group group({
+		az::cli::Arg(1, {"-x", "--first"}, "First").disabled(),
+		az::cli::Arg(2, {"-h", "--help"}, "Second"),
+		az::cli::Arg(3, {"-h", "--hidden"}, "Third"),
+		az::cli::Arg(4, {"-x"}, "Fourth")
+	});
+	BOOST_CHECK_EQUAL(group.find("-h")->id(), 2);
+	BOOST_CHECK_EQUAL(group.find("--hidden")->id(), 3);
+	// disabled arguments are not found
+	BOOST_CHECK_EQUAL(group.find("-x")->id(), 4);
+	BOOST_CHECK(group.find("--first") == nullptr);
+	BOOST_CHECK_EQUAL(group.findShort('h')->id(), 2);
+	BOOST_CHECK_EQUAL(group.findShort('x')->id(), 4);
+	BOOST_CHECK(group.findShort('f') == nullptr);
+
+	az::cli::Group copy(group);
+	BOOST_CHECK_EQUAL(copy.find("-h")->id(), 2);
+	BOOST_CHECK(copy.find("-h") != group.find("-h"));
+}
+
+BOOST_AUTO_TEST_CASE(recognize_disabled_keys)
+{
+	az::cli::Group group({
+		az::cli::Arg(1, {"-v"}, "Old verbose").disabled(),
+		az::cli::Arg(2, {"-v", "--verbose"}, "Verbose"),
+		az::cli::Arg(3, {"-q"}, "Quiet").disabled()
+	});
+	BOOST_REQUIRE(group.find("-v"));
+	BOOST_CHECK_EQUAL(group.find("-v")->id(), 2);
+	BOOST_CHECK(!group.find("-q"));
+	BOOST_CHECK(group.recognize("-q"));
+	BOOST_CHECK(!group.recognize("-x"));
+}
+
+BOOST_AUTO_TEST_CASE(recognize_in_ancestors)
+{
+	az::cli::Argumentation argumentation;
+	argumentation.push(az::cli::Group({
+		az::cli::Arg(1, {"-h", "--help"}, "Help"),
+		az::cli::Arg(2, {"-v", "--verbose"}, "Verbose").disabled()
+	}));
+	argumentation.push(az::cli::Group({
+		az::cli::Arg(3, {"-h", "--hidden"}, "Hidden")
+	}));
+	argumentation.push(az::cli::Group({
+		az::cli::Arg(4, {"-x"}, "Current")
+	}));
+	BOOST_CHECK_EQUAL(argumentation.recognize("-h"), 1);
+	BOOST_CHECK_EQUAL(argumentation.recognize("--help=1"), 0);
+	BOOST_CHECK_EQUAL(argumentation.recognize("-v"), 0);
+	BOOST_CHECK_EQUAL(argumentation.recognize("-x"), -1);
+	BOOST_CHECK_EQUAL(argumentation.recognize("-y"), -1);
+	argumentation.pop();
+	BOOST_CHECK_EQUAL(argumentation.recognize("-h"), 0);
+	BOOST_CHECK_EQUAL(argumentation.recognize("--hidden"), -1);
+	argumentation.pop();
+	BOOST_CHECK_EQUAL(argumentation.recognize("-h"), -1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
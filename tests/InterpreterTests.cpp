@@ -1,6 +1,13 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 #include "tests.hpp"
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <filesystem>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 struct AppFixture
 {
@@ -206,6 +213,41 @@ BOOST_FIXTURE_TEST_CASE(interact, AppFixture)
 	BOOST_CHECK_EQUAL(std::string(context[test::Arg::STRING]), "interactive");
 }
 
+BOOST_FIXTURE_TEST_CASE(interact_asynchronously, AppFixture)
+{
+	std::vector<const char*> argv = {
+		"app", "call", "-i", "1"
+	};
+	// prompts are answered by another thread as an event loop would do; empty answers take default values
+	std::list<std::promise<std::string>> prompts;
+	std::vector<std::thread> answers;
+	auto input = [&](const az::cli::Arg& arg) {
+		auto& prompt = prompts.emplace_back();
+		auto answer = arg.id() == test::Arg::STRING ? "async" : "";
+		answers.emplace_back([&prompt, answer] { prompt.set_value(answer); });
+		return prompt.get_future();
+	};
+	BOOST_REQUIRE_NO_THROW(az::cli::Interpreter(argv.data(), argv.size())
+		.interactively(input, std::chrono::milliseconds(0)).run(app, test::usage));
+	for (auto& answer : answers) {
+		answer.join();
+	}
+	BOOST_CHECK_EQUAL(context[test::Arg::STRING].asString(), "async");
+	BOOST_CHECK_EQUAL(double(context[test::Arg::REAL]), 1.23);
+	BOOST_CHECK_GT(prompts.size(), 1);
+
+	// prompts which are never answered are timed out and default values are taken
+	context = {};
+	prompts.clear();
+	auto silence = [&](const az::cli::Arg&) {
+		return prompts.emplace_back().get_future();
+	};
+	BOOST_REQUIRE_NO_THROW(az::cli::Interpreter(argv.data(), argv.size())
+		.interactively(silence, std::chrono::milliseconds(1)).run(app, test::usage));
+	BOOST_CHECK_NE(context[test::Arg::STRING].asString(), "async");
+	BOOST_CHECK_EQUAL(double(context[test::Arg::REAL]), 1.23);
+}
+
 BOOST_FIXTURE_TEST_CASE(do_not_ignore_unknown, AppFixture)
 {
 	std::vector<const char*> argv = {
@@ -231,6 +273,891 @@ BOOST_FIXTURE_TEST_CASE(ignore_unknown, AppFixture)
 	BOOST_CHECK_EQUAL(context[test::Arg::STRING].asString(), "bsv");
 }
 
+BOOST_FIXTURE_TEST_CASE(accept_abbreviations, AppFixture)
+{
+	std::vector<const char*> argv = {
+		"app", "--ca", "--in=5", "--str", "abbr", "-h", "x"
+	};
+
+	BOOST_REQUIRE_NO_THROW(az::cli::Interpreter(argv.data(), argv.size()).allowAbbreviations().run(app, test::usage));
+	BOOST_CHECK_EQUAL(int(context[test::Arg::INTEGER]), 5);
+	BOOST_CHECK_EQUAL(context[test::Arg::STRING].asString(), "abbr");
+	BOOST_CHECK_EQUAL(context[test::Arg::HIDDEN].asString(), "<tag>x</tag>");
+}
+
+BOOST_FIXTURE_TEST_CASE(reject_ambiguous_abbreviations, AppFixture)
+{
+	std::vector<const char*> argv = {
+		"app", "call", "--int=1", "--"
+	};
+	az::cli::Interpreter interpreter(argv.data(), argv.size());
+	BOOST_REQUIRE_EXCEPTION(interpreter.allowAbbreviations().run(app, test::usage), az::cli::Error, [](const az::cli::Error& error) {
+		return error.code() == az::cli::Error::Code::AmbiguousArgument && error.context.argument == "--" &&
+			error.context.help == "--array, --bool, --hidden, --int, --pair, --real, --string";
+	});
+}
+
+BOOST_AUTO_TEST_CASE(prefer_parent_keys_to_bundles)
+{
+	enum { APP, AB, CMD, A, B };
+	auto usage = [](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		switch (arg.id()) {
+			case APP:
+				return {
+					az::cli::Arg(AB, {"-ab"}, "All").with_value(true),
+					az::cli::Arg(CMD, {"cmd"}, "Command")
+				};
+			case CMD:
+				return {
+					az::cli::Arg(A, {"-a"}, "A").with_value(true),
+					az::cli::Arg(B, {"-b"}, "B").with_value(true)
+				};
+			default:
+				return {};
+		}
+	};
+	std::vector<const char*> argv = {"app", "cmd", "-ab"};
+	az::cli::Context context;
+	az::cli::Interpreter(argv.data(), argv.size()).allowBundling().run(az::cli::Arg(APP, {"app"}, "App"), usage, context);
+	BOOST_CHECK(context.has(AB));
+	BOOST_CHECK(!context.has(A) && !context.has(B));
+	argv = {"app", "cmd", "-ba"};
+	context = {};
+	az::cli::Interpreter(argv.data(), argv.size()).allowBundling().run(az::cli::Arg(APP, {"app"}, "App"), usage, context);
+	BOOST_CHECK(!context.has(AB));
+	BOOST_CHECK(context.has(A) && context.has(B));
+}
+
+BOOST_FIXTURE_TEST_CASE(ignore_ambiguous_abbreviations, AppFixture)
+{
+	std::vector<const char*> argv = {
+		"app", "call", "--int=1", "--", "-", "--str", "x"
+	};
+	BOOST_REQUIRE_NO_THROW(az::cli::Interpreter(argv.data(), argv.size())
+		.allowAbbreviations().ignoreUnknown().run(app, test::usage));
+	BOOST_CHECK_EQUAL(int(context[test::Arg::INTEGER]), 1);
+	BOOST_CHECK_EQUAL(context[test::Arg::STRING].asString(), "x");
+}
+
+BOOST_AUTO_TEST_CASE(prefer_parent_keys_to_abbreviations)
+{
+	enum { APP, VERBOSE, RUN, LEVEL, LIMIT };
+	auto usage = [](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		switch (arg.id()) {
+			case APP:
+				return {
+					az::cli::Arg(VERBOSE, {"--verbose"}, "Verbose").with_value(true),
+					az::cli::Arg(RUN, {"run"}, "Run")
+				};
+			case RUN:
+				return {
+					az::cli::Arg(LEVEL, {"--verbose-level"}, "Level").with_value(),
+					az::cli::Arg(LIMIT, {"--verbose-limit"}, "Limit").with_value()
+				};
+			default:
+				return {};
+		}
+	};
+	std::vector<const char*> argv = {"app", "run", "--verbose"};
+	az::cli::Context context;
+	BOOST_REQUIRE_NO_THROW(az::cli::Interpreter(argv.data(), argv.size()).allowAbbreviations()
+		.run(az::cli::Arg(APP, {"app"}, "App"), usage, context));
+	BOOST_CHECK(bool(context[VERBOSE]));
+	BOOST_CHECK(!context.has(LEVEL));
+	argv = {"app", "run", "--verbose-le", "high"};
+	context = {};
+	BOOST_REQUIRE_NO_THROW(az::cli::Interpreter(argv.data(), argv.size()).allowAbbreviations()
+		.run(az::cli::Arg(APP, {"app"}, "App"), usage, context));
+	BOOST_CHECK_EQUAL(context[LEVEL].asString(), "high");
+}
+
+BOOST_AUTO_TEST_CASE(accept_prefixed_keys)
+{
+	enum { CC, DEFINE, INCLUDE, OUTPUT, BUILD };
+	auto usage = [](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		switch (arg.id()) {
+			case CC:
+				return {
+					az::cli::Arg(DEFINE, {"-D"}, "Define a macro").prefixed().paired().multiple().with_value(),
+					az::cli::Arg(INCLUDE, {"-I", "-Include"}, "Add an include directory").prefixed().multiple().with_value(),
+					az::cli::Arg(BUILD, {"build"}, "Build").with_action([]{ return int(BUILD); })
+				};
+			case BUILD:
+				return {
+					az::cli::Arg(OUTPUT, {"-o"}, "Output file").with_value()
+				};
+			default:
+				return {};
+		}
+	};
+	std::vector<const char*> argv = {
+		"cc", "-DNAME=value", "-I/usr/include", "build", "-o", "a.out", "-DFLAG", "-I", "dir", "-Includes"
+	};
+	az::cli::Context context;
+	BOOST_REQUIRE_EQUAL(az::cli::Interpreter(argv.data(), argv.size()).run(az::cli::Arg(CC, {"cc"}, "Compiler"), usage, context), BUILD);
+	BOOST_REQUIRE_EQUAL(context[DEFINE].size(), 2);
+	BOOST_CHECK_EQUAL(context[DEFINE][0][0].asString(), "NAME");
+	BOOST_CHECK_EQUAL(context[DEFINE][0][1].asString(), "value");
+	BOOST_CHECK_EQUAL(context[DEFINE][1][0].asString(), "FLAG");
+	BOOST_CHECK(context[DEFINE][1][1].isNone());
+	BOOST_REQUIRE_EQUAL(context[INCLUDE].size(), 3);
+	BOOST_CHECK_EQUAL(context[INCLUDE][0].asString(), "/usr/include");
+	BOOST_CHECK_EQUAL(context[INCLUDE][1].asString(), "dir");
+	BOOST_CHECK_EQUAL(context[INCLUDE][2].asString(), "s");
+	BOOST_CHECK_EQUAL(context[OUTPUT].asString(), "a.out");
+}
+
+BOOST_AUTO_TEST_CASE(accept_multiple_values)
+{
+	enum { ZIP, FILES, LEVEL, EXCLUDE };
+	auto usage = [](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		if (arg.id() != ZIP) {
+			return {};
+		}
+		return {
+			az::cli::Arg(FILES, {"-f", "--files"}, "Files to compress").arity(1).with_value(),
+			az::cli::Arg(LEVEL, {"-l", "--level"}, "Compression level").with_value(az::cli::evaluate().integer()),
+			az::cli::Arg(EXCLUDE, {"-x", "--exclude"}, "Files to skip").arity(2, 3).with_value()
+		};
+	};
+	std::vector<const char*> argv = {
+		"zip", "--files=a.txt", "b.txt", "c.txt", "-l", "9", "-x", "d.txt", "e.txt", "f.txt", "g.txt"
+	};
+	az::cli::Context context;
+	// the rest of the values is beyond the limit
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size()).run(az::cli::Arg(ZIP, {"zip"}, "Zip"), usage, context),
+		az::cli::Error::Code::InvalidArgument);
+	BOOST_REQUIRE_EQUAL(context[FILES].size(), 3);
+	BOOST_CHECK_EQUAL(context[FILES][0].asString(), "a.txt");
+	BOOST_CHECK_EQUAL(context[FILES][2].asString(), "c.txt");
+	BOOST_CHECK_EQUAL(int(context[LEVEL]), 9);
+	BOOST_REQUIRE_EQUAL(context[EXCLUDE].size(), 3);
+	BOOST_CHECK_EQUAL(context[EXCLUDE][2].asString(), "f.txt");
+
+	argv = {"zip", "-x", "d.txt", "--files"};
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size()).run(az::cli::Arg(ZIP, {"zip"}, "Zip"), usage),
+		az::cli::Error::Code::TooFew);
+}
+
+BOOST_AUTO_TEST_CASE(bind_values)
+{
+	enum Mode { FAST = 1, SAFE };
+	enum { APP, PORT, RATIO, VERBOSE, NAME, MODE, FILES };
+	int port = 0;
+	double ratio = 0;
+	bool verbose = false;
+	std::string name;
+	Mode mode = FAST;
+	std::vector<std::string> files;
+	auto usage = [&](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		if (arg.id() != APP) {
+			return {};
+		}
+		return {
+			az::cli::Arg(PORT, {"--port"}, "Port").with_value(az::cli::evaluate().integer()).bind_to(port),
+			az::cli::Arg(RATIO, {"--ratio"}, "Ratio").with_value(az::cli::evaluate().real()).bind_to(ratio, true),
+			az::cli::Arg(VERBOSE, {"-v"}, "Verbose").bind_to(verbose, true),
+			az::cli::Arg(NAME, {"--name"}, "Name").with_value().by_default("noname").bind_to(name),
+			az::cli::Arg(MODE, {"--mode"}, "Mode").with_value(az::cli::evaluate().integer()).bind_to(mode),
+			az::cli::Arg(FILES, {"-f"}, "Files").multiple().arity(1).with_value().bind_to(files, true)
+		};
+	};
+	std::vector<const char*> argv = {
+		"app", "--port", "8080", "--ratio=0.5", "-v", "--mode", "2", "-f", "a", "b", "-f", "c"
+	};
+	az::cli::Context context;
+	az::cli::Interpreter(argv.data(), argv.size()).run(az::cli::Arg(APP, {"app"}, "App"), usage, context);
+	BOOST_CHECK_EQUAL(port, 8080);
+	BOOST_CHECK_EQUAL(ratio, 0.5);
+	BOOST_CHECK(verbose);
+	BOOST_CHECK_EQUAL(name, "noname");
+	BOOST_CHECK(mode == SAFE);
+	BOOST_REQUIRE_EQUAL(files.size(), 3);
+	BOOST_CHECK_EQUAL(files[2], "c");
+	// detached arguments are only marked as passed
+	BOOST_CHECK_EQUAL(int(context[PORT]), 8080);
+	BOOST_CHECK(context.has(RATIO) && context[RATIO].isNone());
+	BOOST_CHECK(context.has(FILES) && context[FILES].isNone());
+}
+
+BOOST_AUTO_TEST_CASE(accept_bundled_keys)
+{
+	enum { TAR, EXTRACT, VERBOSE, ARCHIVE, LEVEL };
+	auto usage = [](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		if (arg.id() != TAR) {
+			return {};
+		}
+		return {
+			az::cli::Arg(EXTRACT, {"-x", "--extract"}, "Extract").with_value(true),
+			az::cli::Arg(VERBOSE, {"-v", "--verbose"}, "Verbosity").counting(),
+			az::cli::Arg(ARCHIVE, {"-f", "--file"}, "Archive").with_value(),
+			az::cli::Arg(LEVEL, {"-l"}, "Level").with_value(az::cli::evaluate().integer())
+		};
+	};
+	std::vector<const char*> argv = {"tar", "-xvvf", "a.tar", "-vl9"};
+	az::cli::Context context;
+	az::cli::Interpreter(argv.data(), argv.size()).allowBundling().run(az::cli::Arg(TAR, {"tar"}, "Tar"), usage, context);
+	BOOST_CHECK(bool(context[EXTRACT]));
+	BOOST_CHECK_EQUAL(int(context[VERBOSE]), 3);
+	BOOST_CHECK_EQUAL(context[ARCHIVE].asString(), "a.tar");
+	BOOST_CHECK_EQUAL(int(context[LEVEL]), 9);
+
+	// the counter is provided even if the argument isn't passed
+	argv = {"tar", "-xfa.tar"};
+	context = {};
+	az::cli::Interpreter(argv.data(), argv.size()).allowBundling().run(az::cli::Arg(TAR, {"tar"}, "Tar"), usage, context);
+	BOOST_CHECK_EQUAL(int(context[VERBOSE]), 0);
+	BOOST_CHECK_EQUAL(context[ARCHIVE].asString(), "a.tar");
+
+	argv = {"tar", "-xvz"};
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size()).allowBundling()
+		.run(az::cli::Arg(TAR, {"tar"}, "Tar"), usage), az::cli::Error::Code::InvalidArgument);
+	argv = {"tar", "-xv"};
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size())
+		.run(az::cli::Arg(TAR, {"tar"}, "Tar"), usage), az::cli::Error::Code::InvalidArgument);
+}
+
+BOOST_FIXTURE_TEST_CASE(run_compiled_usage, AppFixture)
+{
+	int calls = 0;
+	az::cli::CompiledUsage compiled(app, [&calls](const az::cli::Arg& arg) {
+		calls++;
+		return test::usage(arg);
+	});
+	int compiling_calls = calls;
+	BOOST_REQUIRE_GT(compiling_calls, 0);
+
+	for (auto value : {"1", "2"}) {
+		std::vector<const char*> argv = {
+			"app", "call", "--int", value, "--string", "bsv"
+		};
+		BOOST_REQUIRE_NO_THROW(az::cli::Interpreter(argv.data(), argv.size()).run(compiled));
+		BOOST_CHECK_EQUAL(std::string(context[test::Arg::INTEGER]), value);
+		BOOST_CHECK_EQUAL(context[test::Arg::STRING].asString(), "bsv");
+	}
+	std::vector<const char*> argv = {
+		"app", "call", "?"
+	};
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size()).run(compiled), az::cli::Error::Code::NeedHelp);
+	BOOST_CHECK_EQUAL(calls, compiling_calls);
+}
+
+BOOST_FIXTURE_TEST_CASE(memoize_usage, AppFixture)
+{
+	int calls = 0;
+	az::cli::UsageCache cache([&calls](const az::cli::Arg& arg) {
+		calls++;
+		return test::usage(arg);
+	});
+	std::vector<const char*> argv = {
+		"app", "call", "--int", "1", "--string", "bsv"
+	};
+	BOOST_REQUIRE_NO_THROW(az::cli::Interpreter(argv.data(), argv.size()).run(app, cache));
+	BOOST_CHECK_EQUAL(int(context[test::Arg::INTEGER]), 1);
+	int first_calls = calls;
+	BOOST_REQUIRE_GT(first_calls, 0);
+
+	// met arguments are described once
+	BOOST_REQUIRE_NO_THROW(az::cli::Interpreter(argv.data(), argv.size()).run(app, cache));
+	BOOST_CHECK_EQUAL(calls, first_calls);
+	argv = {
+		"app", "call", "?"
+	};
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size()).run(app, cache), az::cli::Error::Code::NeedHelp);
+	std::stringstream printed, expected;
+	az::cli::Printer(printed).recursively().print(app, cache);
+	az::cli::Printer(expected).recursively().print(app, test::usage);
+	BOOST_CHECK_EQUAL(printed.str(), expected.str());
+	int printing_calls = calls;
+	az::cli::Printer(printed).recursively().print(app, cache);
+	BOOST_CHECK_EQUAL(calls, printing_calls);
+
+	cache.invalidate(app.id());
+	az::cli::Printer(printed).print(app, cache);
+	BOOST_CHECK_EQUAL(calls, printing_calls + 1);
+	cache.invalidate();
+	az::cli::Printer(printed).recursively().print(app, cache);
+	BOOST_CHECK_EQUAL(calls, printing_calls * 2 + 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(consult_cache_from_usage, AppFixture)
+{
+	// the usage of a sub-argument is made of the cached group of the app, so the cache is requested
+	//   while it's describing an argument
+	const az::cli::UsageCache* self = nullptr;
+	az::cli::UsageCache cache([&self](const az::cli::Arg& arg) {
+		if (arg.id() == test::Arg::CALL) {
+			self->group(az::cli::Arg(test::Arg::APP, {"app"}, "App"));
+		}
+		return test::usage(arg);
+	});
+	self = &cache;
+	std::vector<const char*> argv = {
+		"app", "call", "--int", "1"
+	};
+	BOOST_REQUIRE_NO_THROW(az::cli::Interpreter(argv.data(), argv.size()).run(app, cache));
+	BOOST_CHECK_EQUAL(int(context[test::Arg::INTEGER]), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(reuse_interpreter, AppFixture)
+{
+	std::vector<const char*> argv = {
+		"app", "call", "--int", "1"
+	};
+	az::cli::CompiledUsage compiled(app, test::usage);
+	az::cli::Interpreter interpreter(argv.data(), argv.size());
+	az::cli::Context first;
+	BOOST_CHECK_EQUAL(interpreter.run(compiled, first), test::Arg::CALL);
+	BOOST_CHECK_EQUAL(int(first[test::Arg::INTEGER]), 1);
+
+	// an interrupted run doesn't affect the next one
+	std::vector<const char*> wrong = {
+		"app", "call", "--idk"
+	};
+	az::cli::Context second;
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(interpreter.run(wrong, compiled, second), az::cli::Error::Code::InvalidArgument);
+
+	// there are no actions left from the previous runs
+	std::vector<const char*> other = {
+		"app", "--flag"
+	};
+	az::cli::Context third;
+	BOOST_CHECK_EQUAL(interpreter.run(other, app, test::usage, third), test::Arg::APP);
+	BOOST_CHECK(third.has(test::Arg::FLAG));
+	BOOST_CHECK(!third.has(test::Arg::INTEGER));
+
+	az::cli::Context fourth;
+	BOOST_CHECK_EQUAL(interpreter.reset(argv).run(compiled, fourth), test::Arg::CALL);
+	BOOST_CHECK_EQUAL(int(fourth[test::Arg::INTEGER]), 1);
+}
+
+BOOST_AUTO_TEST_CASE(run_concurrently)
+{
+	enum { APP, GET, ID, HOST, VERBOSE };
+	auto usage = [](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		switch (arg.id()) {
+			case APP:
+				return {
+					az::cli::Arg(GET, {"get"}, "Get").with_action([]{ return int(GET); }),
+					az::cli::Arg(VERBOSE, {"-v", "--verbose"}, "Verbosity").counting()
+				};
+			case GET:
+				return {
+					az::cli::Arg(ID, {"--id"}, "Id").required().with_value(az::cli::evaluate().integer().cached(4)),
+					az::cli::Arg(HOST, {"--host"}, "Host").with_value<az::cli::Ipv4Validator>(az::cli::evaluate().cached())
+				};
+			default:
+				return {};
+		}
+	};
+	const az::cli::CompiledUsage compiled(az::cli::Arg(APP, {"app"}, "App"), usage);
+
+	std::atomic<int> failures = 0;
+	std::vector<std::thread> threads;
+	for (int thread = 0; thread < 8; thread++) {
+		threads.emplace_back([&compiled, &failures, thread] {
+			az::cli::Interpreter interpreter(nullptr, 0);
+			interpreter.allowAbbreviations().allowBundling();
+			for (int run = 0; run < 500; run++) {
+				auto id = std::to_string((thread + run) % 8);
+				std::vector<const char*> argv = {
+					"app", "-vv", "get", "--id", id.c_str(), "--ho", "10.0.0.1"
+				};
+				az::cli::Context context;
+				if (interpreter.run(argv, compiled, context) != GET || int(context[VERBOSE]) != 2 ||
+					std::to_string(int(context[ID])) != id || int64_t(context[HOST]) != 0x0a000001) {
+					failures++;
+				}
+				argv = {"app", "get", "--id", "x"};
+				try {
+					interpreter.run(argv, compiled, context);
+					failures++;
+				}
+				catch (const az::cli::Error& error) {
+					failures += error.code() != az::cli::Error::Code::InvalidValue;
+				}
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	BOOST_CHECK_EQUAL(failures, 0);
+}
+
+BOOST_AUTO_TEST_CASE(perform_in_parallel)
+{
+	enum { APP, FETCH, INDEX, REPORT, FAIL, CLEAN };
+	std::atomic<int> done = 0;
+	std::atomic<int> done_before_report = -1;
+	auto usage = [&](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		if (arg.id() != APP) {
+			return {};
+		}
+		return {
+			az::cli::Arg(FETCH, {"fetch"}, "Fetch").with_action([&] {
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				return int(++done);
+			}),
+			az::cli::Arg(INDEX, {"index"}, "Index").with_action([&] {
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				return int(++done);
+			}),
+			az::cli::Arg(REPORT, {"report"}, "Report").after(FETCH).after(INDEX).with_action([&] {
+				done_before_report = int(done);
+				return int(REPORT);
+			}),
+			az::cli::Arg(FAIL, {"fail"}, "Fail").with_action([]() -> int {
+				throw std::runtime_error("failed");
+			}),
+			az::cli::Arg(CLEAN, {"clean"}, "Clean").after(FAIL).with_action([] { return int(CLEAN); })
+		};
+	};
+	std::vector<const char*> argv = {"app", "report", "fetch", "index"};
+	az::cli::Interpreter interpreter(argv.data(), argv.size());
+	interpreter.doEverything().inParallel(4);
+	BOOST_CHECK_EQUAL(interpreter.run(az::cli::Arg(APP, {"app"}, "App"), usage), APP);
+	BOOST_CHECK_EQUAL(done_before_report, 2);
+	const auto& outcomes = interpreter.getOutcomes();
+	BOOST_REQUIRE_EQUAL(outcomes.size(), 3);
+	BOOST_CHECK_EQUAL(outcomes[0].id, REPORT);
+	BOOST_CHECK_EQUAL(outcomes[0].result, REPORT);
+	BOOST_CHECK(outcomes[1].performed && outcomes[2].performed);
+	BOOST_CHECK_EQUAL(outcomes[1].result + outcomes[2].result, 1 + 2);
+
+	// dependents of a failed action are not performed
+	argv = {"app", "clean", "fail", "fetch"};
+	az::cli::Context context;
+	BOOST_CHECK_THROW(interpreter.run(argv, az::cli::Arg(APP, {"app"}, "App"), usage, context), std::runtime_error);
+	BOOST_REQUIRE_EQUAL(interpreter.getOutcomes().size(), 3);
+	BOOST_CHECK(!interpreter.getOutcomes()[0].performed);
+	BOOST_CHECK(interpreter.getOutcomes()[1].error);
+	BOOST_CHECK(interpreter.getOutcomes()[2].performed && !interpreter.getOutcomes()[2].error);
+}
+
+BOOST_FIXTURE_TEST_CASE(interpret_lines, AppFixture)
+{
+	std::stringstream stream(
+		"call --int 1 --string 'two words'\n"
+		"\n"
+		"call --idk\n"
+		"call ?\n"
+		"call -i 3\n");
+	std::vector<std::string> lines;
+	std::vector<az::cli::Error::Code> errors;
+	auto latency = [&lines](const std::string& line, std::chrono::nanoseconds time) {
+		lines.push_back(line);
+		BOOST_CHECK_GT(time.count(), 0);
+	};
+	auto blame = [&errors](const az::cli::Error& error) {
+		errors.push_back(error.code());
+	};
+	BOOST_CHECK_EQUAL(az::cli::Interpreter(nullptr, 0).repl(stream, app, test::usage, blame, latency), test::Arg::CALL);
+	// empty lines are skipped
+	BOOST_REQUIRE_EQUAL(lines.size(), 4);
+	BOOST_CHECK_EQUAL(lines[1], "call --idk");
+	BOOST_REQUIRE_EQUAL(errors.size(), 2);
+	BOOST_CHECK(errors[0] == az::cli::Error::Code::InvalidArgument);
+	BOOST_CHECK(errors[1] == az::cli::Error::Code::NeedHelp);
+	BOOST_CHECK_EQUAL(int(context[test::Arg::INTEGER]), 3);
+	BOOST_CHECK_EQUAL(context[test::Arg::STRING].asString(), "str");
+}
+
+BOOST_AUTO_TEST_CASE(keep_reading_after_exceptions)
+{
+	enum { APP, FAIL, PASS };
+	auto usage = [](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		if (arg.id() != APP) {
+			return {};
+		}
+		return {
+			az::cli::Arg(FAIL, {"fail"}, "Fail").with_action([]() -> int { throw std::runtime_error("broken"); }),
+			az::cli::Arg(PASS, {"pass"}, "Pass").with_action([] { return int(PASS); })
+		};
+	};
+	std::stringstream stream("fail\npass\n");
+	std::vector<az::cli::Error> errors;
+	auto blame = [&errors](const az::cli::Error& error) {
+		errors.push_back(error);
+	};
+	BOOST_CHECK_EQUAL(az::cli::Interpreter(nullptr, 0).repl(stream, az::cli::Arg(APP, {"app"}, "App"), usage, blame), PASS);
+	BOOST_REQUIRE_EQUAL(errors.size(), 1);
+	BOOST_CHECK(errors[0].code() == az::cli::Error::Code::Unexpected);
+	BOOST_CHECK_EQUAL(errors[0].help(), "broken");
+	BOOST_CHECK_EQUAL(errors[0].value(), "fail");
+}
+
+BOOST_AUTO_TEST_CASE(expand_response_files)
+{
+	enum { CC, DEFINE, INPUT, OUTPUT };
+	auto usage = [](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		if (arg.id() != CC) {
+			return {};
+		}
+		return {
+			az::cli::Arg(DEFINE, {"-D"}, "Define a macro").prefixed().multiple().with_value(),
+			az::cli::Arg(INPUT, {"-i"}, "Input files").arity(1).multiple().with_value(),
+			az::cli::Arg(OUTPUT, {"-o"}, "Output file").with_value()
+		};
+	};
+	auto directory = std::filesystem::temp_directory_path();
+	auto nested = (directory / "az-cli-nested.rsp").string();
+	auto outer = (directory / "az-cli-outer.rsp").string();
+	auto empty = (directory / "az-cli-empty.rsp").string();
+	std::ofstream(nested) << "b.c 'c d.c'\n\t-D\"NAME=\\\"value\\\"\"";
+	std::ofstream(outer) << "-i a.c @" << nested << " @" << empty << "\n-DFLAG";
+	std::ofstream(empty) << " \n";
+
+	auto at_outer = "@" + outer;
+	std::vector<const char*> argv = {"cc", at_outer.c_str(), "-o", "a.out"};
+	az::cli::Context context;
+	az::cli::Interpreter(argv.data(), argv.size()).expandFiles().run(az::cli::Arg(CC, {"cc"}, "Compiler"), usage, context);
+	BOOST_REQUIRE_EQUAL(context[INPUT].size(), 1);
+	BOOST_REQUIRE_EQUAL(context[INPUT][0].size(), 3);
+	BOOST_CHECK_EQUAL(context[INPUT][0][0].asString(), "a.c");
+	BOOST_CHECK_EQUAL(context[INPUT][0][1].asString(), "b.c");
+	BOOST_CHECK_EQUAL(context[INPUT][0][2].asString(), "c d.c");
+	BOOST_REQUIRE_EQUAL(context[DEFINE].size(), 2);
+	BOOST_CHECK_EQUAL(context[DEFINE][0].asString(), "NAME=\"value\"");
+	BOOST_CHECK_EQUAL(context[DEFINE][1].asString(), "FLAG");
+	BOOST_CHECK_EQUAL(context[OUTPUT].asString(), "a.out");
+
+	// files are not expanded by default
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size())
+		.run(az::cli::Arg(CC, {"cc"}, "Compiler"), usage), az::cli::Error::Code::InvalidArgument);
+	argv = {"cc", "@/nonexistent/file"};
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size()).expandFiles()
+		.run(az::cli::Arg(CC, {"cc"}, "Compiler"), usage), az::cli::Error::Code::InvalidArgument);
+
+	// files referring to each other are expanded till the limit
+	std::ofstream(nested) << "@" << nested;
+	argv = {"cc", at_outer.c_str()};
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size()).expandFiles()
+		.run(az::cli::Arg(CC, {"cc"}, "Compiler"), usage), az::cli::Error::Code::InvalidArgument);
+	std::filesystem::remove(nested);
+	std::filesystem::remove(outer);
+	std::filesystem::remove(empty);
+
+	// an unclosed quote is located in the file
+	std::ofstream(outer) << "-i a.c\n'b.c";
+	argv = {"cc", at_outer.c_str()};
+	BOOST_REQUIRE_EXCEPTION(az::cli::Interpreter(argv.data(), argv.size()).expandFiles()
+		.run(az::cli::Arg(CC, {"cc"}, "Compiler"), usage), az::cli::Error, [&](const az::cli::Error& error) {
+		return error.code() == az::cli::Error::Code::InvalidEnd && error.argument() == at_outer &&
+			error.file() == outer && error.line() == 2;
+	});
+	std::filesystem::remove(outer);
+
+	// pipes have no size, but they're expanded as well
+	int pipe_ends[2];
+	BOOST_REQUIRE_EQUAL(pipe(pipe_ends), 0);
+	std::string piped = "-i x.c y.c";
+	BOOST_REQUIRE_EQUAL(write(pipe_ends[1], piped.data(), piped.size()), ssize_t(piped.size()));
+	close(pipe_ends[1]);
+	auto at_pipe = "@/dev/fd/" + std::to_string(pipe_ends[0]);
+	argv = {"cc", at_pipe.c_str()};
+	context = {};
+	az::cli::Interpreter(argv.data(), argv.size()).expandFiles().run(az::cli::Arg(CC, {"cc"}, "Compiler"), usage, context);
+	close(pipe_ends[0]);
+	BOOST_REQUIRE_EQUAL(context[INPUT].size(), 1);
+	BOOST_CHECK_EQUAL(context[INPUT][0].size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(take_values_from_environment)
+{
+	enum { APP, PORT, HOST, DEBUG, LEVEL };
+	auto usage = [](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		if (arg.id() != APP) {
+			return {};
+		}
+		return {
+			az::cli::Arg(PORT, {"--port"}, "Port").from_env("AZ_CLI_TEST_PORT")
+				.with_value(az::cli::evaluate().integer().max(65535)).by_default(80),
+			az::cli::Arg(HOST, {"--host"}, "Host").from_env("AZ_CLI_TEST_HOST").with_value().by_default("localhost"),
+			az::cli::Arg(DEBUG, {"--debug"}, "Debug").from_env("AZ_CLI_TEST_DEBUG").with_value(true),
+			az::cli::Arg(LEVEL, {"--level"}, "Level").from_env("AZ_CLI_TEST_UNSET").with_value().by_default("info")
+		};
+	};
+	setenv("AZ_CLI_TEST_PORT", "8080", 1);
+	setenv("AZ_CLI_TEST_HOST", "example.com", 1);
+	setenv("AZ_CLI_TEST_DEBUG", "yes", 1);
+	unsetenv("AZ_CLI_TEST_UNSET");
+
+	std::vector<const char*> argv = {"app", "--host", "cli.com"};
+	az::cli::Context context;
+	az::cli::Interpreter(argv.data(), argv.size()).run(az::cli::Arg(APP, {"app"}, "App"), usage, context);
+	BOOST_CHECK_EQUAL(int(context[PORT]), 8080);
+	BOOST_CHECK_EQUAL(context[HOST].asString(), "cli.com");
+	BOOST_CHECK(bool(context[DEBUG]));
+	BOOST_CHECK_EQUAL(context[LEVEL].asString(), "info");
+
+	setenv("AZ_CLI_TEST_PORT", "100000", 1);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size())
+		.run(az::cli::Arg(APP, {"app"}, "App"), usage), az::cli::Error::Code::TooLarge);
+	unsetenv("AZ_CLI_TEST_PORT");
+	unsetenv("AZ_CLI_TEST_HOST");
+	unsetenv("AZ_CLI_TEST_DEBUG");
+}
+
+BOOST_AUTO_TEST_CASE(take_flags_and_counters_from_environment)
+{
+	enum { APP, DEBUG, VERBOSE };
+	auto usage = [](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		if (arg.id() != APP) {
+			return {};
+		}
+		return {
+			az::cli::Arg(DEBUG, {"--debug"}, "Debug").from_env("AZ_CLI_TEST_DEBUG").with_value(true),
+			az::cli::Arg(VERBOSE, {"-v"}, "Verbosity").from_env("AZ_CLI_TEST_VERBOSE").counting()
+		};
+	};
+	std::vector<const char*> argv = {"app"};
+	// empty variables are taken as unset ones
+	setenv("AZ_CLI_TEST_DEBUG", "", 1);
+	setenv("AZ_CLI_TEST_VERBOSE", "", 1);
+	az::cli::Context context;
+	az::cli::Interpreter(argv.data(), argv.size()).run(az::cli::Arg(APP, {"app"}, "App"), usage, context);
+	BOOST_CHECK(!context.has(DEBUG));
+	BOOST_CHECK_EQUAL(int(context[VERBOSE]), 0);
+
+	setenv("AZ_CLI_TEST_VERBOSE", "3", 1);
+	context = az::cli::Context();
+	az::cli::Interpreter(argv.data(), argv.size()).run(az::cli::Arg(APP, {"app"}, "App"), usage, context);
+	BOOST_CHECK_EQUAL(int(context[VERBOSE]), 3);
+
+	// a passed counter wins over the variable
+	std::vector<const char*> passed = {"app", "-v", "-v"};
+	context = az::cli::Context();
+	az::cli::Interpreter(passed.data(), passed.size()).run(az::cli::Arg(APP, {"app"}, "App"), usage, context);
+	BOOST_CHECK_EQUAL(int(context[VERBOSE]), 2);
+
+	setenv("AZ_CLI_TEST_VERBOSE", "3x", 1);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size())
+		.run(az::cli::Arg(APP, {"app"}, "App"), usage), az::cli::Error::Code::InvalidValue);
+	unsetenv("AZ_CLI_TEST_DEBUG");
+	unsetenv("AZ_CLI_TEST_VERBOSE");
+}
+
+BOOST_AUTO_TEST_CASE(take_values_from_configuration)
+{
+	enum { APP, PORT, HOST, DEBUG, LEVEL, REMOTE, ADD, NAME };
+	auto usage = [](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		switch (arg.id()) {
+		case APP: return {
+			az::cli::Arg(PORT, {"-p", "--port"}, "Port").with_value(az::cli::evaluate().integer().max(65535)).by_default(80),
+			az::cli::Arg(HOST, {"--host"}, "Host").with_value().by_default("localhost"),
+			az::cli::Arg(DEBUG, {"--debug"}, "Debug").with_value(true),
+			az::cli::Arg(LEVEL, {"--level"}, "Level").with_value().by_default("info"),
+			az::cli::Arg(REMOTE, {"remote"}, "Remote")
+		};
+		case REMOTE: return {az::cli::Arg(ADD, {"add"}, "Add")};
+		case ADD: return {az::cli::Arg(NAME, {"--name"}, "Name").with_value()};
+		default: return {};
+		}
+	};
+	auto directory = std::filesystem::temp_directory_path();
+	auto system = (directory / "az-cli-system.ini").string();
+	auto user = (directory / "az-cli-user.ini").string();
+	std::ofstream(system) << "# system wide\nport = 8080\nhost = system.com\n\n[remote.add]\nname = origin\n";
+	std::ofstream(user) << "; overrides\r\nhost = \"user.com\"\r\ndebug=yes";
+	az::cli::Configuration configuration;
+	configuration.load(system).load(user);
+
+	std::vector<const char*> argv = {"app", "--port", "81", "remote", "add"};
+	az::cli::Context context;
+	az::cli::Interpreter(argv.data(), argv.size()).configure(&configuration)
+		.run(az::cli::Arg(APP, {"app"}, "App"), usage, context);
+	BOOST_CHECK_EQUAL(int(context[PORT]), 81);
+	BOOST_CHECK_EQUAL(context[HOST].asString(), "user.com");
+	BOOST_CHECK(bool(context[DEBUG]));
+	BOOST_CHECK_EQUAL(context[LEVEL].asString(), "info");
+	BOOST_CHECK_EQUAL(context[NAME].asString(), "origin");
+
+	// invalid values are blamed at their lines
+	std::ofstream(user) << "\n[remote]\n\n[]\n";
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Configuration().load(user), az::cli::Error::Code::InvalidValue);
+	std::ofstream(user) << "port = 100000\n";
+	configuration.load(user);
+	argv = {"app"};
+	BOOST_REQUIRE_EXCEPTION(az::cli::Interpreter(argv.data(), argv.size()).configure(&configuration)
+		.run(az::cli::Arg(APP, {"app"}, "App"), usage), az::cli::Error, [&](const az::cli::Error& error) {
+		return error.code() == az::cli::Error::Code::TooLarge && error.file() == user && error.line() == 1;
+	});
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Configuration().load("/nonexistent/file"),
+		az::cli::Error::Code::InvalidArgument);
+	std::filesystem::remove(system);
+	std::filesystem::remove(user);
+}
+
+BOOST_AUTO_TEST_CASE(stream_values)
+{
+	enum { APP, ID, NUMBER, NAME };
+	std::vector<int> numbers;
+	std::vector<std::string> names;
+	auto usage = [&numbers, &names](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		if (arg.id() != APP) {
+			return {};
+		}
+		return {
+			az::cli::Arg(ID, {"--id"}, "Ids").streamed().with_value(az::cli::evaluate().integer()),
+			az::cli::Arg(NUMBER, {"--number"}, "Numbers").streamed('\0').with_value().bind_to(numbers, true),
+			az::cli::Arg(NAME, {"--name"}, "Names").streamed().with_value().unique().bind_to(names, true)
+		};
+	};
+	auto directory = std::filesystem::temp_directory_path();
+	auto ids_path = (directory / "az-cli-ids.txt").string();
+	auto numbers_path = (directory / "az-cli-numbers.txt").string();
+	std::ofstream(ids_path) << "1\n2\r\n\n3";
+	{
+		// enough values to be split by chunks
+		std::ofstream file(numbers_path, std::ios::binary);
+		for (int i = 0; i < 20000; i++) {
+			file << i << '\0';
+		}
+	}
+	int ids_file = open(ids_path.c_str(), O_RDONLY);
+	int numbers_file = open(numbers_path.c_str(), O_RDONLY);
+	BOOST_REQUIRE(ids_file >= 0 && numbers_file >= 0);
+	auto at_ids = "&" + std::to_string(ids_file);
+	auto at_numbers = "&" + std::to_string(numbers_file);
+
+	std::vector<const char*> argv = {"app", "--id", at_ids.c_str(), "--id", "4", "--number", at_numbers.c_str()};
+	az::cli::Context context;
+	// descriptors are read only if they're allowed
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size())
+		.run(az::cli::Arg(APP, {"app"}, "App"), usage), az::cli::Error::Code::InvalidValue);
+	az::cli::Interpreter(argv.data(), argv.size()).allowDescriptors()
+		.run(az::cli::Arg(APP, {"app"}, "App"), usage, context);
+	BOOST_REQUIRE_EQUAL(context[ID].size(), 4);
+	BOOST_CHECK_EQUAL(int(context[ID][0]), 1);
+	BOOST_CHECK_EQUAL(int(context[ID][1]), 2);
+	BOOST_CHECK_EQUAL(int(context[ID][2]), 3);
+	BOOST_CHECK_EQUAL(int(context[ID][3]), 4);
+	// detached values are not kept
+	BOOST_CHECK(context.has(NUMBER));
+	BOOST_CHECK_EQUAL(context[NUMBER].size(), 0);
+	BOOST_REQUIRE_EQUAL(numbers.size(), 20000);
+	BOOST_CHECK_EQUAL(numbers.back(), 19999);
+	close(ids_file);
+	close(numbers_file);
+
+	std::ofstream(ids_path) << "1\nx\n";
+	ids_file = open(ids_path.c_str(), O_RDONLY);
+	at_ids = "&" + std::to_string(ids_file);
+	argv = {"app", "--id", at_ids.c_str()};
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size()).allowDescriptors()
+		.run(az::cli::Arg(APP, {"app"}, "App"), usage), az::cli::Error::Code::InvalidValue);
+	close(ids_file);
+	// a closed descriptor can't be read
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size()).allowDescriptors()
+		.run(az::cli::Arg(APP, {"app"}, "App"), usage), az::cli::Error::Code::InvalidValue);
+
+	// unique values are checked by a hash set even if they're detached
+	std::ofstream(ids_path) << "a\nb\nc\nb\n";
+	ids_file = open(ids_path.c_str(), O_RDONLY);
+	at_ids = "&" + std::to_string(ids_file);
+	argv = {"app", "--name", at_ids.c_str()};
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size()).allowDescriptors()
+		.run(az::cli::Arg(APP, {"app"}, "App"), usage), az::cli::Error::Code::DuplicateValue);
+	BOOST_CHECK_EQUAL(names.size(), 3);
+	close(ids_file);
+	std::filesystem::remove(ids_path);
+	std::filesystem::remove(numbers_path);
+}
+
+BOOST_AUTO_TEST_CASE(consume_each_value)
+{
+	enum { APP, ID, NAME };
+	int64_t sum = 0;
+	std::vector<std::string> names;
+	auto usage = [&](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		if (arg.id() != APP) {
+			return {};
+		}
+		return {
+			az::cli::Arg(ID, {"--id"}, "Ids").multiple().arity(1).with_value(az::cli::evaluate().integer())
+				.on_each([&sum](const az::cli::Value& value) {
+					if (int64_t(value) < 0) {
+						throw std::runtime_error("negative id");
+					}
+					sum += int64_t(value);
+				}, 2),
+			az::cli::Arg(NAME, {"--name"}, "Names").multiple().unique().with_value()
+				.on_each([&names](const az::cli::Value& value) { names.push_back(value.asString()); })
+		};
+	};
+	std::vector<const char*> argv = {"app", "--id", "1", "2", "3", "--name", "a", "--id", "4", "--name", "b"};
+	az::cli::Context context;
+	az::cli::Interpreter(argv.data(), argv.size()).run(az::cli::Arg(APP, {"app"}, "App"), usage, context);
+	BOOST_CHECK_EQUAL(sum, 10);
+	BOOST_REQUIRE_EQUAL(names.size(), 2);
+	BOOST_CHECK_EQUAL(names[1], "b");
+	// values are not kept
+	BOOST_CHECK(context.has(ID));
+	BOOST_CHECK_EQUAL(context[ID].size(), 0);
+	BOOST_CHECK_EQUAL(context[NAME].size(), 0);
+
+	argv = {"app", "--name", "a", "--name", "a"};
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(az::cli::Interpreter(argv.data(), argv.size())
+		.run(az::cli::Arg(APP, {"app"}, "App"), usage), az::cli::Error::Code::DuplicateValue);
+	argv = {"app", "--id", "1", "-2", "3"};
+	BOOST_CHECK_THROW(az::cli::Interpreter(argv.data(), argv.size())
+		.run(az::cli::Arg(APP, {"app"}, "App"), usage), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(consume_values_by_runs)
+{
+	enum { APP, NAME, MODE, ID, IDS };
+	std::atomic<int64_t> sum = 0;
+	az::cli::CompiledUsage compiled(az::cli::Arg(APP, {"app"}, "App"), [&sum](const az::cli::Arg& arg) -> std::list<az::cli::Arg> {
+		if (arg.id() != APP) {
+			return {};
+		}
+		return {
+			az::cli::Arg(NAME, {"--name"}, "Names").multiple().unique().with_value().on_each([](const az::cli::Value&) {}),
+			az::cli::Arg(MODE, {"--mode"}, "Mode").with_value().on_each([](const az::cli::Value&) {}),
+			az::cli::Arg(ID, {"--id"}, "Ids").multiple().with_value(az::cli::evaluate().integer())
+				.on_each([&sum](const az::cli::Value& value) { sum += int64_t(value); }, 4),
+			az::cli::Arg(IDS, {"--ids"}, "Ids").arity(1).with_value(az::cli::evaluate().integer())
+				.on_each([&sum](const az::cli::Value& value) { sum += int64_t(value); })
+		};
+	});
+	// an interrupted run doesn't leave passed values to the next one
+	az::cli::Interpreter interpreter(nullptr, 0);
+	az::cli::Context context;
+	std::vector<const char*> argv = {"app", "--name", "a", "--bogus"};
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(interpreter.run(argv, compiled, context), az::cli::Error::Code::InvalidArgument);
+	argv = {"app", "--name", "a"};
+	BOOST_REQUIRE_NO_THROW(interpreter.run(argv, compiled, context));
+	argv = {"app", "--mode", "a", "--mode", "b"};
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(interpreter.run(argv, compiled, context), az::cli::Error::Code::Multiple);
+	// values of one passed argument are consumed one by one
+	argv = {"app", "--ids", "1", "2", "3"};
+	context = az::cli::Context();
+	BOOST_REQUIRE_NO_THROW(interpreter.run(argv, compiled, context));
+	BOOST_CHECK_EQUAL(sum.load(), 6);
+	argv = {"app", "--ids", "1", "--ids", "2"};
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(interpreter.run(argv, compiled, context), az::cli::Error::Code::Multiple);
+	sum = 0;
+
+	// runs sharing the usage consume their values by their own workers
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; i++) {
+		threads.emplace_back([&compiled] {
+			std::vector<const char*> argv = {"app", "--id", "1", "--id", "2", "--id", "3", "--name", "a"};
+			az::cli::Interpreter interpreter(nullptr, 0);
+			for (int run = 0; run < 50; run++) {
+				az::cli::Context context;
+				interpreter.run(argv, compiled, context);
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	BOOST_CHECK_EQUAL(sum.load(), 4 * 50 * 6);
+}
+
 BOOST_FIXTURE_TEST_CASE(need_value, AppFixture)
 {
 	std::vector<const char*> argv = {
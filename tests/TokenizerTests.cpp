@@ -0,0 +1,68 @@
+#include "tests.hpp"
+
+BOOST_AUTO_TEST_SUITE(TokenizerTests)
+
+BOOST_AUTO_TEST_CASE(split_by_spaces)
+{
+	az::cli::Tokenizer tokenizer;
+	auto args = tokenizer.split("  call\t--int 1  -s=str ");
+	BOOST_REQUIRE_EQUAL(args.size(), 4);
+	BOOST_CHECK_EQUAL(args[0], "call");
+	BOOST_CHECK_EQUAL(args[1], "--int");
+	BOOST_CHECK_EQUAL(args[2], "1");
+	BOOST_CHECK_EQUAL(args[3], "-s=str");
+	BOOST_CHECK(tokenizer.split(" \t ").empty());
+}
+
+BOOST_AUTO_TEST_CASE(split_with_quotes)
+{
+	az::cli::Tokenizer tokenizer;
+	auto args = tokenizer.split(R"(say 'it is' "a \"quoted\" \\ \n" it\ is --s="" x'y'"z")");
+	BOOST_REQUIRE_EQUAL(args.size(), 6);
+	BOOST_CHECK_EQUAL(args[0], "say");
+	BOOST_CHECK_EQUAL(args[1], "it is");
+	BOOST_CHECK_EQUAL(args[2], R"(a "quoted" \ \n)");
+	BOOST_CHECK_EQUAL(args[3], "it is");
+	BOOST_CHECK_EQUAL(args[4], "--s=");
+	BOOST_CHECK_EQUAL(args[5], "xyz");
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(tokenizer.split("say 'unclosed"), az::cli::Error::Code::InvalidEnd);
+}
+
+BOOST_AUTO_TEST_CASE(split_long_lines)
+{
+	az::cli::Tokenizer tokenizer;
+	std::string long_word(40, 'w');
+	std::string line = "app " + long_word + " '" + long_word + " quoted " + long_word + "'\t" +
+		"\"double \\\"quoted\\\" " + long_word + "\"" + long_word + "\\ " + long_word + " end";
+	auto args = tokenizer.split(line, "first");
+	BOOST_REQUIRE_EQUAL(args.size(), 6);
+	BOOST_CHECK_EQUAL(args[0], "first");
+	BOOST_CHECK_EQUAL(args[1], "app");
+	BOOST_CHECK_EQUAL(args[2], long_word);
+	BOOST_CHECK_EQUAL(args[3], long_word + " quoted " + long_word);
+	BOOST_CHECK_EQUAL(args[4], "double \"quoted\" " + long_word + long_word + " " + long_word);
+	BOOST_CHECK_EQUAL(args[5], "end");
+
+	auto tokens = tokenizer.tokens();
+	BOOST_REQUIRE_EQUAL(tokens.size(), 5);
+	BOOST_CHECK_EQUAL(tokens[2].size(), long_word.size() * 2 + 8);
+	BOOST_CHECK(tokens[4] == "end");
+
+	auto cursor = tokenizer.cursor();
+	BOOST_CHECK_EQUAL(cursor.arg(), "first");
+	BOOST_CHECK_EQUAL((++cursor).arg(), "app");
+}
+
+BOOST_AUTO_TEST_CASE(find_chars)
+{
+	std::string line(100, 'a');
+	BOOST_CHECK_EQUAL(az::cli::Tokenizer::find(line, 0, " '"), line.size());
+	for (size_t pos : {0, 15, 16, 17, 63, 98, 99}) {
+		line[pos] = '\'';
+		BOOST_CHECK_EQUAL(az::cli::Tokenizer::find(line, pos > 0 ? pos - 1 : 0, " '"), pos);
+		BOOST_CHECK_EQUAL(az::cli::Tokenizer::find(line, pos, "'"), pos);
+		line[pos] = 'a';
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,56 @@
+#include "tests.hpp"
+
+BOOST_AUTO_TEST_SUITE(TrieTests)
+
+BOOST_AUTO_TEST_CASE(find_keys)
+{
+	az::cli::Argument verbose(1, {"-v", "--verbose"}, "Verbose"), version(2, {"--version"}, "Version");
+	az::cli::Trie trie;
+	trie.insert("-v", &verbose);
+	trie.insert("--verbose", &verbose);
+	trie.insert("--version", &version);
+	trie.insert("-v", &version);
+
+	BOOST_CHECK(trie.find("-v") == &verbose);
+	BOOST_CHECK(trie.find("--version") == &version);
+	BOOST_CHECK(trie.find("--ver") == nullptr);
+	BOOST_CHECK(trie.find("") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(complete_prefixes)
+{
+	az::cli::Argument verbose(1, {"-v", "--verbose"}, "Verbose"), version(2, {"--version"}, "Version");
+	az::cli::Trie trie;
+	trie.insert("--verbose", &verbose);
+	trie.insert("--verbosity", &verbose);
+	trie.insert("--version", &version);
+
+	std::vector<std::string_view> candidates;
+	BOOST_CHECK(trie.complete("--verb", &candidates) == &verbose);
+	BOOST_CHECK(trie.complete("--vers", &candidates) == &version);
+	BOOST_CHECK(candidates.empty());
+	BOOST_CHECK(trie.complete("--x", &candidates) == nullptr);
+	BOOST_CHECK(candidates.empty());
+	BOOST_CHECK(trie.complete("--ver", &candidates) == nullptr);
+	BOOST_REQUIRE_EQUAL(candidates.size(), 3);
+	BOOST_CHECK_EQUAL(candidates[0], "--verbose");
+	BOOST_CHECK_EQUAL(candidates[1], "--verbosity");
+	BOOST_CHECK_EQUAL(candidates[2], "--version");
+}
+
+BOOST_AUTO_TEST_CASE(find_longest_prefix)
+{
+	az::cli::Argument define(1, {"-D"}, "Define"), dump(2, {"-Dump"}, "Dump");
+	az::cli::Trie trie;
+	trie.insert("-D", &define);
+	trie.insert("-Dump", &dump);
+
+	size_t length = 0;
+	BOOST_CHECK(trie.findLongestPrefix("-DNAME=1", length) == &define);
+	BOOST_CHECK_EQUAL(length, 2);
+	BOOST_CHECK(trie.findLongestPrefix("-Dumpster", length) == &dump);
+	BOOST_CHECK_EQUAL(length, 5);
+	BOOST_CHECK(trie.findLongestPrefix("-I/usr", length) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,29 @@
 #include "tests.hpp"
 
+// Validator which counts calls of check() to make sure of memoization
+struct CountingValidator : public az::cli::Validator
+{
+	mutable int checks = 0;
+	bool check(const std::string& source) const override {
+		checks++;
+		return Validator::check(source);
+	}
+};
+
+struct UncacheableValidator : public CountingValidator
+{
+	bool isCacheable() const override {
+		return false;
+	}
+};
+
+struct ThrowingValidator : public az::cli::Validator
+{
+	bool check(const std::string&) const override {
+		throw std::runtime_error("broken");
+	}
+};
+
 BOOST_AUTO_TEST_SUITE(ValidatorTests)
 
 BOOST_AUTO_TEST_CASE(check_min_number)
@@ -170,4 +194,76 @@ BOOST_AUTO_TEST_CASE(apply_glossary)
 	BOOST_CHECK_EQUAL(validator.apply("bad").asString(), "bad");
 }
 
+BOOST_AUTO_TEST_CASE(stream_by_chunks)
+{
+	auto validator = az::cli::Validator().string().min(3).max(8).no_repeats_of("-").cannot_end_with("-");
+	auto stream = validator.stream();
+	// the cyrillic character is split between chunks
+	BOOST_REQUIRE_NO_THROW(stream.feed("a-\xd1").feed("\x8f-b").finish());
+	BOOST_CHECK_EQUAL(stream.length(), 5);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.stream().feed("a-").feed("-b"), az::cli::Error::Code::RepetitiveChar);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.stream().feed("abcd").feed("efghi"), az::cli::Error::Code::TooLong);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.stream().feed("ab").finish(), az::cli::Error::Code::TooShort);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.stream().feed("abc").feed("-").finish(), az::cli::Error::Code::InvalidEnd);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.stream().feed("abc\xd1").finish(), az::cli::Error::Code::InvalidValue);
+}
+
+BOOST_AUTO_TEST_CASE(stream_by_buffer)
+{
+	auto validator = az::cli::Validator().pattern("\\d+");
+	BOOST_REQUIRE_NO_THROW(validator.stream().feed("12").feed("34").finish());
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.stream().feed("12").feed("a4").finish(), az::cli::Error::Code::InvalidValue);
+}
+
+BOOST_AUTO_TEST_CASE(cache_results)
+{
+	CountingValidator validator;
+	validator.integer().max(10).cached(2);
+	BOOST_CHECK_EQUAL(int(validator.validate("5")), 5);
+	BOOST_CHECK_EQUAL(int(validator.validate("5")), 5);
+	BOOST_CHECK_EQUAL(validator.checks, 1);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("11"), az::cli::Error::Code::TooLarge);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(validator.validate("11"), az::cli::Error::Code::TooLarge);
+	BOOST_CHECK_EQUAL(validator.checks, 2);
+	// "5" is the least recently used one, so it is evicted
+	BOOST_CHECK_EQUAL(int(validator.validate("7")), 7);
+	BOOST_CHECK_EQUAL(int(validator.validate("5")), 5);
+	BOOST_CHECK_EQUAL(validator.checks, 4);
+}
+
+BOOST_AUTO_TEST_CASE(renew_cache_of_changed_copies)
+{
+	auto base = az::cli::evaluate().integer().cached();
+	auto small = base;
+	small.max(10);
+	BOOST_CHECK_EQUAL(int(base.validate("11")), 11);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(small.validate("11"), az::cli::Error::Code::TooLarge);
+	// results of the former rules are dropped
+	base.max(5);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(base.validate("11"), az::cli::Error::Code::TooLarge);
+	auto merged = az::cli::evaluate().integer().cached();
+	BOOST_CHECK_EQUAL(int(merged.validate("7")), 7);
+	merged += az::cli::evaluate().max(5);
+	CUSTOM_REQUIRE_THROW_CLI_ERROR(merged.validate("7"), az::cli::Error::Code::TooLarge);
+}
+
+BOOST_AUTO_TEST_CASE(propagate_foreign_exceptions)
+{
+	ThrowingValidator validator;
+	BOOST_CHECK_THROW(validator.validate("1"), std::runtime_error);
+	// the cache doesn't change what is thrown
+	validator.cached();
+	BOOST_CHECK_THROW(validator.validate("1"), std::runtime_error);
+	BOOST_CHECK_THROW(validator.validate("1"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(do_not_cache_uncacheable)
+{
+	UncacheableValidator validator;
+	validator.integer().cached();
+	BOOST_CHECK_EQUAL(int(validator.validate("1")), 1);
+	BOOST_CHECK_EQUAL(int(validator.validate("1")), 1);
+	BOOST_CHECK_EQUAL(validator.checks, 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -3,7 +3,15 @@
 #include "Error.h"
 #include "Value.h"
 #include "Validator.h"
+#include "Formats.h"
 #include "Argument.h"
+#include "Trie.h"
+#include "Group.h"
+#include "CompiledUsage.h"
+#include "UsageCache.h"
+#include "Tokenizer.h"
+#include "Environment.h"
+#include "Configuration.h"
 #include "Interpreter.h"
 #include "Printer.h"
 